@@ -6,7 +6,19 @@ dirs=(
     ./source/port/mac/
     ./source/port/stm32/
     ./test/utl/dbg/
+    ./test/utl/cbf/
+    ./test/utl/cbf_bench/
+    ./test/utl/cobs/
+    ./test/utl/arq/
+    ./test/utl/cobs_bench/
+    ./test/utl/crc16/
+    ./test/utl/crc16_bench/
+    ./test/utl/crc/
+    ./test/utl/crc32c/
+    ./test/utl/crc32c_bench/
+    ./test/utl/io/
     ./test/hal/cpu/
+    ./test/hal/crc/
     ./test/hal/uart/
 )
 
@@ -3,6 +3,7 @@
 void hal_deinit(void)
 {
     hal_uart_deinit();
+    hal_crc_deinit();
     hal_cpu_deinit();
 }
 
@@ -11,6 +12,7 @@ void hal_init(void)
     utl_dbg_init();
     utl_dbg_mod_enable(UTL_DBG_MOD_PORT);
     hal_cpu_init();
+    hal_crc_init();
     hal_uart_init();
     hal_gps_init();
 
@@ -34,10 +34,12 @@ extern "C"
 #include "hal_cpu.h"
 #include "hal_uart.h"
 #include "hal_gps.h"
+#include "hal_crc.h"
 
 extern const hal_cpu_driver_t* HAL_CPU_DRIVER;
 extern const hal_uart_driver_t* HAL_UART_DRIVER;
 extern const hal_gps_driver_t* HAL_GPS_DRIVER;
+extern const hal_crc_driver_t* HAL_CRC_DRIVER;
 
 void hal_init(void);
 void hal_deinit(void);
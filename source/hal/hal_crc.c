@@ -0,0 +1,28 @@
+#include "hal.h"
+
+void hal_crc_init(void)
+{
+    HAL_CRC_DRIVER->init();
+}
+
+void hal_crc_deinit(void)
+{
+    HAL_CRC_DRIVER->deinit();
+}
+
+uint32_t hal_crc_data(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc)
+{
+    return HAL_CRC_DRIVER->data(type, data, len, acc);
+}
+
+uint32_t hal_crc_initial(hal_crc_type_t type)
+{
+    static const uint32_t initial[HAL_CRC_NUM_TYPES] = {
+        [HAL_CRC_CRC16_CCITT] = 0xFFFF,
+        [HAL_CRC_CRC16_MODBUS] = 0xFFFF,
+        [HAL_CRC_CRC32] = 0,
+        [HAL_CRC_CRC32C] = 0,
+    };
+
+    return initial[type];
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// CRC variants with hardware support on the ports that have a CRC unit (any 8/16/32-bit polynomial)
+typedef enum hal_crc_type_e
+{
+    // CRC-16/CCITT-FALSE, same as utl_crc16 (COBS frames, ARQ)
+    HAL_CRC_CRC16_CCITT = 0,
+    // CRC-16/MODBUS
+    HAL_CRC_CRC16_MODBUS,
+    // CRC-32 (Ethernet, zlib)
+    HAL_CRC_CRC32,
+    // CRC-32C (Castagnoli), same as utl_crc32c
+    HAL_CRC_CRC32C,
+    HAL_CRC_NUM_TYPES,
+} hal_crc_type_t;
+
+// Drivers keep no state between calls, and the ones with a shared CRC unit must not be called from more than
+// one context (ex: thread and interrupt) at the same time
+typedef struct hal_crc_driver_s
+{
+    void (*init)(void);
+    void (*deinit)(void);
+    uint32_t (*data)(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc);
+} hal_crc_driver_t;
+
+void hal_crc_init(void);
+void hal_crc_deinit(void);
+// acc is the CRC of the data before this call: hal_crc_initial() to start, or a previous result to continue
+uint32_t hal_crc_data(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc);
+// CRC of empty data (initial value with the final xor applied)
+uint32_t hal_crc_initial(hal_crc_type_t type);
+
+#define hal_crc(type, data, len) hal_crc_data(type, data, len, hal_crc_initial(type))
+
+#ifdef __cplusplus
+}
+#endif
@@ -242,12 +242,14 @@ static ssize_t nmea_read_sentence(hal_gps_dev_t dev, char *sentence, size_t max_
 
     while (idx + 1 < max_len) { // Garante espaço para o '\0'
         // Verifica se o tempo limite para a leitura da sentença foi excedido
-        if (hal_cpu_time_get_ms() - start_time_ms > SENTENCE_READ_TIMEOUT_MS) {
+        uint32_t elapsed_ms = hal_cpu_time_get_ms() - start_time_ms;
+        if (elapsed_ms >= SENTENCE_READ_TIMEOUT_MS) {
             printf("nmea_read_sentence: Timeout occurred.\n"); // Mensagem de debug
             break; // Sai do loop se o timeout for atingido
         }
 
-        ssize_t bytes_read = hal_uart_read(ctx->uart_dev, &c, 1); // Tenta ler um byte da UART
+        // Dorme até chegar um byte ou acabar o tempo restante (sem polling)
+        ssize_t bytes_read = hal_uart_read_timeout(ctx->uart_dev, &c, 1, SENTENCE_READ_TIMEOUT_MS - elapsed_ms);
 
         if (bytes_read == 1) { // Caractere lido com sucesso
             start_time_ms = hal_cpu_time_get_ms(); // Reinicia o contador de tempo para o próximo caractere
@@ -275,9 +277,9 @@ static ssize_t nmea_read_sentence(hal_gps_dev_t dev, char *sentence, size_t max_
             if (c == '\n') {
                 break; // Sai do loop, a sentença foi completamente lida
             }
-        } else if (bytes_read == 0) { // Nenhum byte lido no momento (buffer vazio)
-            // Espera um pouco se não houver bytes disponíveis para evitar consumir 100% da CPU
-            hal_cpu_sleep_ms(1); // Cede tempo da CPU por 1ms
+        } else if (bytes_read == 0) { // Nenhum byte lido antes do prazo
+            // read_timeout pode retornar sem dormir (ex: porta em modo callback); cede a CPU por 1ms
+            hal_cpu_sleep_ms(1);
         } else { // bytes_read < 0 (erro na leitura da UART)
             printf("nmea_read_sentence: UART read error.\n"); // Mensagem de debug
             break; // Sai do loop em caso de erro de leitura
@@ -38,6 +38,11 @@ ssize_t hal_uart_read(hal_uart_dev_t dev, uint8_t* buffer, size_t size)
     return HAL_UART_DRIVER->read(dev, buffer, size);
 }
 
+ssize_t hal_uart_read_timeout(hal_uart_dev_t dev, uint8_t* buffer, size_t size, uint32_t timeout_ms)
+{
+    return HAL_UART_DRIVER->read_timeout(dev, buffer, size, timeout_ms);
+}
+
 ssize_t hal_uart_write(hal_uart_dev_t dev, uint8_t* buffer, size_t size)
 {
     // return drv->write(dev, buffer, size);
@@ -80,6 +80,7 @@ typedef struct hal_uart_driver_s {
 
     size_t    (*bytes_available)(hal_uart_dev_t dev);                    /**< Verifica bytes disponíveis para leitura */
     ssize_t   (*read)(hal_uart_dev_t dev, uint8_t* buffer, size_t size); /**< Lê dados da UART */
+    ssize_t   (*read_timeout)(hal_uart_dev_t dev, uint8_t* buffer, size_t size, uint32_t timeout_ms); /**< Lê dados aguardando até timeout_ms */
     ssize_t   (*write)(hal_uart_dev_t dev, uint8_t* buffer, size_t size);/**< Escreve dados na UART */
     void      (*flush)(hal_uart_dev_t dev);                              /**< Garante envio de todos os dados */
 } hal_uart_driver_t;
@@ -124,6 +125,20 @@ size_t hal_uart_bytes_available(hal_uart_dev_t dev);
  */
 ssize_t hal_uart_read(hal_uart_dev_t dev, uint8_t* buffer, size_t size);
 
+/**
+ * @brief Lê dados da UART, aguardando a chegada de pelo menos um byte.
+ *
+ * A thread chamadora dorme até que dados sejam recebidos ou o tempo se esgote,
+ * sem polling.
+ *
+ * @param dev Handle da UART.
+ * @param buffer Buffer de destino.
+ * @param size Tamanho máximo a ser lido.
+ * @param timeout_ms Tempo máximo de espera em milissegundos.
+ * @return Número de bytes lidos, 0 se o tempo se esgotou, ou -1 em caso de erro.
+ */
+ssize_t hal_uart_read_timeout(hal_uart_dev_t dev, uint8_t* buffer, size_t size, uint32_t timeout_ms);
+
 /**
  * @brief Escreve dados na UART.
  * @param dev Handle da UART.
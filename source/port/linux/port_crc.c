@@ -0,0 +1,54 @@
+/**
+ * @file port_crc.c
+ * @brief Implementação da HAL CRC para Linux, em software.
+ *
+ * Cada tipo usa o kernel mais rápido disponível: utl_crc16_data (PCLMULQDQ quando a CPU suporta),
+ * utl_crc32c_data (instrução crc32 do SSE4.2) e as tabelas slice-by-N do utl_crc para os demais.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hal_crc.h"
+#include "utl_crc.h"
+#include "utl_crc16.h"
+#include "utl_crc32c.h"
+
+static void linux_crc_init(void)
+{
+}
+
+static void linux_crc_deinit(void)
+{
+}
+
+static uint32_t linux_crc_spec_data(const utl_crc_spec_t* spec, const uint8_t* data, size_t len, uint32_t acc)
+{
+    return utl_crc_final(spec, utl_crc_update(spec, utl_crc_resume(spec, acc), data, len));
+}
+
+static uint32_t linux_crc_data(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc)
+{
+    switch(type)
+    {
+    case HAL_CRC_CRC16_CCITT:
+        // sem xor final, o resultado anterior é o próprio registrador
+        return utl_crc16_data(data, len, (uint16_t) acc);
+    case HAL_CRC_CRC16_MODBUS:
+        return linux_crc_spec_data(&utl_crc16_modbus_spec, data, len, acc);
+    case HAL_CRC_CRC32:
+        return linux_crc_spec_data(&utl_crc32_spec, data, len, acc);
+    case HAL_CRC_CRC32C:
+        return utl_crc32c_data(data, len, acc);
+    default:
+        return 0;
+    }
+}
+
+static const hal_crc_driver_t linux_crc_driver = {
+    .init = linux_crc_init,
+    .deinit = linux_crc_deinit,
+    .data = linux_crc_data,
+};
+
+const hal_crc_driver_t* HAL_CRC_DRIVER = &linux_crc_driver;
@@ -26,10 +26,23 @@
 /// Número máximo de portas suportadas (espelhando HAL_UART_NUM_PORTS)
 #define MAX_PORTS HAL_UART_NUM_PORTS
 
-<<<<<<< HEAD
-/// Tamanho do buffer circular interno por porta
+/// Tamanho do buffer circular interno por porta (potência de 2)
 #define UART_BUF_SIZE 512
 
+/// Com buffer cheio, descarta os bytes mais antigos (1) ou os recém-chegados (0)
+#define UART_BUF_OVERWRITE 0
+
+/// Quantidade máxima de bytes lidos do PTY a cada chamada de read()
+#define UART_RX_CHUNK_SIZE 128
+
+/// Intervalo de verificação de espaço livre com o buffer circular cheio (us)
+#define UART_RX_FULL_POLL_US 1000
+
+/// Diretório onde criar o link "uartN" para o lado escravo de cada PTY (vazio: desabilitado)
+#ifndef UART_PTY_LINK_DIR
+#define UART_PTY_LINK_DIR ""
+#endif
+
 /**
  * @brief Estrutura interna representando uma porta UART em Linux.
  */
@@ -40,18 +53,11 @@ typedef struct {
     uint8_t cb_buf[UART_BUF_SIZE]; ///< Buffer real alocado
     pthread_t thread;              ///< Thread de leitura RX
     bool in_use;                   ///< Flag de uso
-=======
-typedef struct
-{
-    int fd;
-    hal_uart_config_t cfg;
->>>>>>> linux_branch
 } linux_uart_t;
 
 /// Lista de portas UART ativas
 static linux_uart_t ports[MAX_PORTS];
 
-<<<<<<< HEAD
 // ─────────────────────────────────────────────
 // RX THREAD
 // ─────────────────────────────────────────────
@@ -61,18 +67,32 @@ static linux_uart_t ports[MAX_PORTS];
  */
 static void* rx_thread(void* arg) {
     linux_uart_t* p = (linux_uart_t*)arg;
-    uint8_t c;
+    uint8_t chunk[UART_RX_CHUNK_SIZE];
     while (p->in_use) {
-        int n = read(p->fd, &c, 1);
-        if (n > 0) {
-            if (p->cfg.interrupt_callback) {
-                p->cfg.interrupt_callback(c);
-            } else {
-                utl_cbf_put(&p->cb, c);
+        ssize_t n;
+        size_t len = 0;
+        uint8_t* dst = p->cfg.interrupt_callback ? NULL : utl_cbf_write_reserve(&p->cb, &len);
+        if (dst) {
+            // leitura direta para a memória do buffer circular
+            n = read(p->fd, dst, len);
+            if (n > 0) utl_cbf_write_commit(&p->cb, (size_t)n);
+        } else if (p->cfg.interrupt_callback || UART_BUF_OVERWRITE) {
+            // modo callback, ou sobrescrita com buffer cheio: drena o PTY num buffer local
+            n = read(p->fd, chunk, sizeof(chunk));
+            if (n > 0) {
+                if (p->cfg.interrupt_callback) {
+                    for (ssize_t i = 0; i < n; i++) p->cfg.interrupt_callback(chunk[i]);
+                } else {
+                    utl_cbf_write(&p->cb, chunk, (size_t)n);
+                }
             }
         } else {
-            usleep(5000);
+            // buffer cheio: os dados ficam no PTY, cujo buffer no kernel segura o transmissor, até o
+            // consumidor liberar espaço
+            usleep(UART_RX_FULL_POLL_US);
+            continue;
         }
+        if (n <= 0) usleep(5000);
     }
     UTL_DBG_PRINTF(UTL_DBG_MOD_UART, "Stopping RX thread for fd %d\n", p->fd);
     return NULL;
@@ -92,16 +112,6 @@ static int configure_port(int fd, hal_uart_config_t* cfg) {
     struct termios tty;
     if (tcgetattr(fd, &tty) != 0) return -1;
     
-=======
-// --- Helpers de configuração termios ---
-static int configure_port(int fd, hal_uart_config_t* cfg)
-{
-    struct termios tty;
-    if(tcgetattr(fd, &tty) != 0)
-        return -1;
-
-    // baud rate
->>>>>>> linux_branch
     speed_t speed;
     switch(cfg->baud_rate)
     {
@@ -125,7 +135,6 @@ static int configure_port(int fd, hal_uart_config_t* cfg)
     }
     cfsetispeed(&tty, speed);
     cfsetospeed(&tty, speed);
-<<<<<<< HEAD
     
     tty.c_cflag &= ~(PARENB | PARODD | CSTOPB | CRTSCTS);
     if (cfg->parity == HAL_UART_PARITY_ODD)   tty.c_cflag |= (PARENB | PARODD);
@@ -155,7 +164,10 @@ static int configure_port(int fd, hal_uart_config_t* cfg)
 static void linux_uart_init(void) {
     memset(ports, 0, sizeof(ports));
     for (int i = 0; i < MAX_PORTS; i++) {
+        ports[i].fd = -1;
         utl_cbf_init(&ports[i].cb, ports[i].cb_buf, UART_BUF_SIZE);
+        utl_cbf_overwrite_set(&ports[i].cb, UART_BUF_OVERWRITE);
+        utl_cbf_wait_set(&ports[i].cb, true); // linux_uart_read_timeout dorme no buffer
     }
 }
 
@@ -194,75 +206,16 @@ static hal_uart_dev_t linux_uart_open(hal_uart_port_t id, hal_uart_config_t* cfg
     utl_cbf_flush(&p->cb);
 
     pthread_create(&p->thread, NULL, rx_thread, p);
-=======
-
-    // parity
-    tty.c_cflag &= ~(PARENB | PARODD);
-    if(cfg->parity == HAL_UART_PARITY_ODD)
-        tty.c_cflag |= PARODD | PARENB;
-    if(cfg->parity == HAL_UART_PARITY_EVEN)
-        tty.c_cflag |= PARENB;
-
-    // stop bits
-    tty.c_cflag &= ~CSTOPB;
-    if(cfg->stop_bits == HAL_UART_STOP_BITS_2)
-        tty.c_cflag |= CSTOPB;
-
-    // flow control
-    tty.c_cflag &= ~CRTSCTS;
-    if(cfg->flow_control == HAL_UART_FLOW_CONTROL_CTS_RTS)
-        tty.c_cflag |= CRTSCTS;
-
-    tty.c_cflag |= (CLOCAL | CREAD);
-    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG); // raw mode
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-    tty.c_oflag &= ~OPOST;
-
-    // apply
-    if(tcsetattr(fd, TCSANOW, &tty) != 0)
-        return -1;
-    return 0;
-}
 
-// --- Driver functions ---
-static void linux_uart_init(void)
-{
-    memset(ports, 0, sizeof(ports));
-}
-
-static void linux_uart_deinit(void)
-{
-    for(int i = 0; i < MAX_PORTS; i++)
-    {
-        if(ports[i].fd > 0)
-            close(ports[i].fd);
-    }
-}
-
-static hal_uart_dev_t linux_uart_open(hal_uart_port_t id, hal_uart_config_t* cfg)
-{
-    if(id < 0 || id >= MAX_PORTS)
-        return NULL;
-
-    int master_fd, slave_fd;
-    char slave_name[64];
-    if(openpty(&master_fd, &slave_fd, slave_name, NULL, NULL) < 0)
-        return NULL;
-
-    // configuramos o master_fd
-    if(configure_port(master_fd, cfg) < 0)
-    {
-        close(master_fd);
-        close(slave_fd);
-        return NULL;
+    // caminho fixo para o outro lado da porta (ex: testes que conectam duas portas)
+    if (UART_PTY_LINK_DIR[0]) {
+        char link_name[128];
+        snprintf(link_name, sizeof(link_name), "%s/uart%d", UART_PTY_LINK_DIR, id);
+        unlink(link_name);
+        if (symlink(slave_name, link_name) < 0) perror(link_name);
     }
 
-    ports[id].fd = master_fd;
-    ports[id].cfg = *cfg;
->>>>>>> linux_branch
-
     fprintf(stderr, "[UART%d] virtual port: %s\n", id, slave_name);
-<<<<<<< HEAD
     return (hal_uart_dev_t)p;
 }
 
@@ -272,25 +225,23 @@ static hal_uart_dev_t linux_uart_open(hal_uart_port_t id, hal_uart_config_t* cfg
  */
 static void linux_uart_close(hal_uart_dev_t dev) {
     linux_uart_t* p = (linux_uart_t*)dev;
+    utl_cbf_stats_t stats;
     if (!p->in_use) return;
     p->in_use = false;
     pthread_join(p->thread, NULL);
-=======
-
-    return (hal_uart_dev_t) &ports[id];
-}
-
-static void linux_uart_close(hal_uart_dev_t dev)
-{
-    linux_uart_t* p = (linux_uart_t*) dev;
-    if(!p || p->fd < 0)
-        return;
->>>>>>> linux_branch
     close(p->fd);
     p->fd = -1;
+    if (UART_PTY_LINK_DIR[0]) {
+        char link_name[128];
+        snprintf(link_name, sizeof(link_name), "%s/uart%d", UART_PTY_LINK_DIR, (int)(p - ports));
+        unlink(link_name);
+    }
+    // subsídio para dimensionar UART_BUF_SIZE
+    utl_cbf_stats_get(&p->cb, &stats);
+    UTL_DBG_PRINTF(UTL_DBG_MOD_UART, "UART RX: %u bytes, %u dropped, high-water %u/%u\n",
+                   stats.total, stats.dropped, stats.high_water, UART_BUF_SIZE);
 }
 
-<<<<<<< HEAD
 /**
  * @brief Retorna número de bytes disponíveis no buffer RX.
  * @param dev Handle UART
@@ -312,12 +263,21 @@ static size_t linux_uart_bytes_available(hal_uart_dev_t dev) {
 static ssize_t linux_uart_read(hal_uart_dev_t dev, uint8_t* buf, size_t sz) {
     linux_uart_t* p = (linux_uart_t*)dev;
     if (p->cfg.interrupt_callback) return 0;
-    size_t available = utl_cbf_bytes_available(&p->cb);
-    size_t to_read = available < sz ? available : sz;
-    for (size_t i = 0; i < to_read; i++) {
-        if (utl_cbf_get(&p->cb, &buf[i]) == UTL_CBF_EMPTY) break;
-    }
-    return to_read;
+    return utl_cbf_read(&p->cb, buf, sz);
+}
+
+/**
+ * @brief Lê dados do buffer RX, dormindo até a chegada de dados ou o fim do timeout.
+ * @param dev Handle UART
+ * @param buf Buffer de destino
+ * @param sz Tamanho máximo a ler
+ * @param timeout_ms Tempo máximo de espera
+ * @return Número de bytes lidos (0 em timeout)
+ */
+static ssize_t linux_uart_read_timeout(hal_uart_dev_t dev, uint8_t* buf, size_t sz, uint32_t timeout_ms) {
+    linux_uart_t* p = (linux_uart_t*)dev;
+    if (p->cfg.interrupt_callback) return 0;
+    return utl_cbf_read_wait(&p->cb, buf, sz, timeout_ms);
 }
 
 /**
@@ -338,41 +298,6 @@ static ssize_t linux_uart_write(hal_uart_dev_t dev, uint8_t* buf, size_t sz) {
  */
 static void linux_uart_flush(hal_uart_dev_t dev) {
     linux_uart_t* p = (linux_uart_t*)dev;
-=======
-static size_t linux_uart_bytes_available(hal_uart_dev_t dev)
-{
-    linux_uart_t* p = (linux_uart_t*) dev;
-    if(!p || p->fd < 0)
-        return 0;
-    fd_set rfds;
-    struct timeval tv = {0};
-    FD_ZERO(&rfds);
-    FD_SET(p->fd, &rfds);
-    return select(p->fd + 1, &rfds, NULL, NULL, &tv) > 0 ? 1 : 0;
-}
-
-static ssize_t linux_uart_read(hal_uart_dev_t dev, uint8_t* buf, size_t sz)
-{
-    linux_uart_t* p = (linux_uart_t*) dev;
-    if(!p || p->fd < 0)
-        return -1;
-    return read(p->fd, buf, sz);
-}
-
-static ssize_t linux_uart_write(hal_uart_dev_t dev, uint8_t* buf, size_t sz)
-{
-    linux_uart_t* p = (linux_uart_t*) dev;
-    if(!p || p->fd < 0)
-        return -1;
-    return write(p->fd, buf, sz);
-}
-
-static void linux_uart_flush(hal_uart_dev_t dev)
-{
-    linux_uart_t* p = (linux_uart_t*) dev;
-    if(!p || p->fd < 0)
-        return;
->>>>>>> linux_branch
     tcdrain(p->fd);
 }
 
@@ -392,6 +317,7 @@ static const hal_uart_driver_t linux_uart_driver = {
     .close = linux_uart_close,
     .bytes_available = linux_uart_bytes_available,
     .read = linux_uart_read,
+    .read_timeout = linux_uart_read_timeout,
     .write = linux_uart_write,
     .flush = linux_uart_flush,
 };
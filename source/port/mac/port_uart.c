@@ -11,7 +11,9 @@
 #include "utl_dbg.h"
 #include "utl_cbf.h"
 
-#define PORT_UART_BUFFER_SIZE 512
+#define PORT_UART_BUFFER_SIZE 512 // must be a power of 2
+#define PORT_UART_BUFFER_OVERWRITE 0 // 1: discard oldest bytes instead of new ones when full
+#define PORT_UART_RX_CHUNK_SIZE 128
 #define PORT_FILE_NAME_LEN 64
 
 static void port_uart_close(hal_uart_dev_t pdev);
@@ -38,7 +40,7 @@ static struct hal_uart_dev_s port_uart_ctrl[] = {
 
 static void* port_uart_rx_thread(void* thread_param)
 {
-    uint8_t c;
+    uint8_t chunk[PORT_UART_RX_CHUNK_SIZE];
     struct hal_uart_dev_s* pdev = (struct hal_uart_dev_s*) thread_param;
 
     UTL_DBG_PRINTF(UTL_DBG_MOD_UART, "Starting thread for port %s\n", pdev->name);
@@ -47,18 +49,21 @@ static void* port_uart_rx_thread(void* thread_param)
     {
         if(pdev->in_use)
         {
-            int n = read(pdev->file, &c, 1);
+            ssize_t n = read(pdev->file, chunk, sizeof(chunk));
             if(n <= 0)
             {
                 usleep(5000);
             }
             else
             {
-                // UTL_DBG_PRINTF(UTL_DBG_MOD_UART, "RX %02X\n",c);
+                // UTL_DBG_DUMP(UTL_DBG_MOD_UART, chunk, n);
                 if(pdev->cfg.interrupt_callback)
-                    pdev->cfg.interrupt_callback(c);
+                {
+                    for(ssize_t pos = 0; pos < n; pos++)
+                        pdev->cfg.interrupt_callback(chunk[pos]);
+                }
                 else
-                    utl_cbf_put(pdev->cb, c);
+                    utl_cbf_write(pdev->cb, chunk, (size_t) n);
             }
         }
         else
@@ -96,6 +101,8 @@ static void port_uart_init(void)
         port_uart_ctrl[dev].in_use = false;
         port_uart_ctrl[dev].cbk = 0;
         port_uart_ctrl[dev].file = -1;
+        utl_cbf_overwrite_set(port_uart_ctrl[dev].cb, PORT_UART_BUFFER_OVERWRITE);
+        utl_cbf_wait_set(port_uart_ctrl[dev].cb, true); // port_uart_read_timeout dorme no buffer
         utl_cbf_flush(port_uart_ctrl[dev].cb);
     }
 }
@@ -237,11 +244,17 @@ static void port_uart_close(hal_uart_dev_t pdev)
 {
     if(pdev->in_use)
     {
+        utl_cbf_stats_t stats;
 
         pdev->in_use = false;
         pthread_join(pdev->thread, NULL);
         close(pdev->file);
         pdev->file = -1;
+
+        // subsídio para dimensionar PORT_UART_BUFFER_SIZE
+        utl_cbf_stats_get(pdev->cb, &stats);
+        UTL_DBG_PRINTF(UTL_DBG_MOD_UART, "Port %s RX: %u bytes, %u dropped, high-water %u/%u\n", pdev->name,
+                       stats.total, stats.dropped, stats.high_water, PORT_UART_BUFFER_SIZE);
     }
 }
 
@@ -261,24 +274,19 @@ static size_t port_uart_bytes_available(hal_uart_dev_t pdev)
 
 static ssize_t port_uart_read(hal_uart_dev_t pdev, uint8_t* buffer, size_t size)
 {
-    ssize_t pos = 0;
-
     // data are not stored on buffers when using interrupt
     if(pdev->cfg.interrupt_callback)
         return 0;
 
-    if(port_uart_bytes_available(pdev) == 0)
-        return 0;
-
-    while(pos < size)
-    {
-        if(utl_cbf_get(pdev->cb, &buffer[pos]) == UTL_CBF_EMPTY)
-            break;
+    return (ssize_t) utl_cbf_read(pdev->cb, buffer, size);
+}
 
-        pos++;
-    }
+static ssize_t port_uart_read_timeout(hal_uart_dev_t pdev, uint8_t* buffer, size_t size, uint32_t timeout_ms)
+{
+    if(pdev->cfg.interrupt_callback)
+        return 0;
 
-    return pos;
+    return (ssize_t) utl_cbf_read_wait(pdev->cb, buffer, size, timeout_ms);
 }
 
 static ssize_t port_uart_write(hal_uart_dev_t pdev, uint8_t* buffer, size_t size)
@@ -328,6 +336,7 @@ hal_uart_driver_t HAL_UART_DRIVER = {
     .close = port_uart_close,
     .bytes_available = port_uart_bytes_available,
     .read = port_uart_read,
+    .read_timeout = port_uart_read_timeout,
     .write = port_uart_write,
     .flush = port_uart_flush,
 };
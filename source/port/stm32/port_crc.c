@@ -0,0 +1,131 @@
+#include <string.h>
+
+#include "main.h"
+#include "hal.h"
+#include "utl_crc.h"
+#include "utl_crc16.h"
+#include "utl_crc32c.h"
+
+// Families with a programmable CRC unit (F0, F3, F7, G0, G4, L0, L4, H7...) have CRC_CR_POLYSIZE. The fixed
+// CRC-32 unit of F1/F2/F4 takes only whole words in an order that does not match the byte stream, so those
+// families use the software kernels, like the Linux port.
+#if defined(CRC_CR_POLYSIZE)
+#define PORT_CRC_HW_ENABLED 1
+#else
+#define PORT_CRC_HW_ENABLED 0
+#endif
+
+#if PORT_CRC_HW_ENABLED == 1
+// The unit sits on AHB4 on H7 and on AHB1 on the other families
+#if defined(LL_AHB4_GRP1_PERIPH_CRC)
+#define PORT_CRC_CLK_ENABLE() LL_AHB4_GRP1_EnableClock(LL_AHB4_GRP1_PERIPH_CRC)
+#define PORT_CRC_CLK_DISABLE() LL_AHB4_GRP1_DisableClock(LL_AHB4_GRP1_PERIPH_CRC)
+#else
+#define PORT_CRC_CLK_ENABLE() LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC)
+#define PORT_CRC_CLK_DISABLE() LL_AHB1_GRP1_DisableClock(LL_AHB1_GRP1_PERIPH_CRC)
+#endif
+
+typedef struct port_crc_cfg_s
+{
+    uint32_t poly;
+    uint32_t poly_size;
+    uint32_t xorout;
+    uint8_t width;
+    bool reflected;
+} port_crc_cfg_t;
+
+static const port_crc_cfg_t port_crc_cfgs[HAL_CRC_NUM_TYPES] = {
+    [HAL_CRC_CRC16_CCITT] = {0x1021, LL_CRC_POLYLENGTH_16B, 0x0000, 16, false},
+    [HAL_CRC_CRC16_MODBUS] = {0x8005, LL_CRC_POLYLENGTH_16B, 0x0000, 16, true},
+    [HAL_CRC_CRC32] = {0x04C11DB7, LL_CRC_POLYLENGTH_32B, 0xFFFFFFFF, 32, true},
+    [HAL_CRC_CRC32C] = {0x1EDC6F41, LL_CRC_POLYLENGTH_32B, 0xFFFFFFFF, 32, true},
+};
+
+static uint32_t port_crc_reflect(uint32_t value, uint8_t width)
+{
+    return __RBIT(value) >> (32 - width);
+}
+
+static void port_crc_init(void)
+{
+    PORT_CRC_CLK_ENABLE();
+}
+
+static void port_crc_deinit(void)
+{
+    PORT_CRC_CLK_DISABLE();
+}
+
+// The unit shifts MSB first with the register in plain (not reflected) form. Reflected variants use the
+// byte-wise input reversal, while the output reversal and the final xor are done here, so any previous result
+// can be loaded back as the initial value.
+static uint32_t port_crc_data(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc)
+{
+    const port_crc_cfg_t* cfg = &port_crc_cfgs[type];
+    uint32_t reg = acc ^ cfg->xorout;
+
+    LL_CRC_SetPolynomialSize(CRC, cfg->poly_size);
+    LL_CRC_SetPolynomialCoef(CRC, cfg->poly);
+    LL_CRC_SetInputDataReverseMode(CRC, cfg->reflected ? LL_CRC_INDATA_REVERSE_BYTE : LL_CRC_INDATA_REVERSE_NONE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_NONE);
+    LL_CRC_SetInitialData(CRC, cfg->reflected ? port_crc_reflect(reg, cfg->width) : reg);
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+
+    // words are shifted from bit 31 down, so the first byte goes to the top
+    while(len >= 4)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        LL_CRC_FeedData32(CRC, __REV(word));
+        data += 4;
+        len -= 4;
+    }
+
+    while(len-- > 0)
+        LL_CRC_FeedData8(CRC, *(data++));
+
+    reg = LL_CRC_ReadData32(CRC);
+    if(cfg->width < 32)
+        reg &= (UINT32_C(1) << cfg->width) - 1;
+
+    return (cfg->reflected ? port_crc_reflect(reg, cfg->width) : reg) ^ cfg->xorout;
+}
+#else
+static void port_crc_init(void)
+{
+}
+
+static void port_crc_deinit(void)
+{
+}
+
+static uint32_t port_crc_spec_data(const utl_crc_spec_t* spec, const uint8_t* data, size_t len, uint32_t acc)
+{
+    return utl_crc_final(spec, utl_crc_update(spec, utl_crc_resume(spec, acc), data, len));
+}
+
+static uint32_t port_crc_data(hal_crc_type_t type, const uint8_t* data, size_t len, uint32_t acc)
+{
+    switch(type)
+    {
+    case HAL_CRC_CRC16_CCITT:
+        return utl_crc16_data(data, len, (uint16_t) acc);
+    case HAL_CRC_CRC16_MODBUS:
+        return port_crc_spec_data(&utl_crc16_modbus_spec, data, len, acc);
+    case HAL_CRC_CRC32:
+        return port_crc_spec_data(&utl_crc32_spec, data, len, acc);
+    case HAL_CRC_CRC32C:
+        return utl_crc32c_data(data, len, acc);
+    default:
+        return 0;
+    }
+}
+#endif
+
+static const hal_crc_driver_t port_crc_driver = {
+    .init = port_crc_init,
+    .deinit = port_crc_deinit,
+    .data = port_crc_data,
+};
+
+const hal_crc_driver_t* HAL_CRC_DRIVER = &port_crc_driver;
@@ -0,0 +1,291 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "hal.h"
+#include "utl_arq.h"
+#include "utl_cobs.h"
+
+_Static_assert((UTL_ARQ_WINDOW_MAX & (UTL_ARQ_WINDOW_MAX - 1)) == 0, "UTL_ARQ_WINDOW_MAX must be a power of 2");
+_Static_assert(UTL_ARQ_WINDOW_MAX >= 1 && UTL_ARQ_WINDOW_MAX <= 32, "UTL_ARQ_WINDOW_MAX must be between 1 and 32");
+_Static_assert(UTL_ARQ_PAYLOAD_MAX >= 1 && UTL_ARQ_FRAME_MAX <= UINT16_MAX, "invalid UTL_ARQ_PAYLOAD_MAX");
+
+#define ARQ_TYPE_DATA 0x01 // seq + mensagem
+#define ARQ_TYPE_ACK 0x02  // sequência acumulada + mapa de bits (32 bits, little endian) dos quadros seguintes
+#define ARQ_TYPE_NACK 0x03 // seq do quadro a retransmitir
+
+#define ARQ_ACK_SIZE (UTL_ARQ_HEADER_SIZE + 4)
+#define ARQ_SLOT(seq) ((uint8_t) (seq) & (UTL_ARQ_WINDOW_MAX - 1))
+#define ARQ_RX_CHUNK_SIZE 64
+
+static void arq_write(utl_arq_t* arq, uint8_t* frame, size_t len)
+{
+    // uma escrita incompleta vira um quadro inválido no outro lado e é recuperada pela retransmissão
+    hal_uart_write(arq->dev, frame, len);
+}
+
+static void arq_ctrl_send(utl_arq_t* arq, const uint8_t* msg, size_t len)
+{
+    uint8_t frame[COBS_FRAME_SIZE(ARQ_ACK_SIZE)];
+
+    arq_write(arq, frame, cobs_frame_encode(msg, frame, len));
+}
+
+static void arq_ack_send(utl_arq_t* arq)
+{
+    uint8_t msg[ARQ_ACK_SIZE] = {ARQ_TYPE_ACK, arq->rx_base};
+    uint32_t sack = 0;
+
+    // quadros já guardados depois da lacuna, que o transmissor não precisa repetir
+    for(uint8_t n = 1; n < arq->cfg.window; n++)
+    {
+        if(arq->rx[ARQ_SLOT(arq->rx_base + n)].valid)
+            sack |= UINT32_C(1) << (n - 1);
+    }
+
+    msg[2] = (uint8_t) sack;
+    msg[3] = (uint8_t) (sack >> 8);
+    msg[4] = (uint8_t) (sack >> 16);
+    msg[5] = (uint8_t) (sack >> 24);
+    arq_ctrl_send(arq, msg, sizeof(msg));
+    arq->ack_pending = false;
+}
+
+static void arq_nack_send(utl_arq_t* arq, uint8_t seq)
+{
+    uint8_t msg[UTL_ARQ_HEADER_SIZE] = {ARQ_TYPE_NACK, seq};
+
+    arq_ctrl_send(arq, msg, sizeof(msg));
+    arq->stats.nacks_sent++;
+}
+
+static void arq_retransmit(utl_arq_t* arq, utl_arq_tx_slot_t* slot)
+{
+    if(arq->cfg.max_retries && slot->retries >= arq->cfg.max_retries)
+    {
+        arq->failed = true;
+        return;
+    }
+
+    slot->retries++;
+    slot->sent_ms = hal_cpu_time_get_ms();
+    arq_write(arq, slot->frame, slot->len);
+    arq->stats.tx_retransmits++;
+}
+
+static void arq_data_handle(utl_arq_t* arq, uint8_t seq, const uint8_t* data, size_t len)
+{
+    uint8_t off = (uint8_t) (seq - arq->rx_base);
+    utl_arq_rx_slot_t* slot = &arq->rx[ARQ_SLOT(seq)];
+
+    // fora da janela só pode ser um quadro antigo cujo ACK se perdeu: basta confirmar de novo
+    arq->ack_pending = true;
+    if(off >= arq->cfg.window || slot->valid)
+    {
+        arq->stats.rx_duplicates++;
+        return;
+    }
+
+    memcpy(slot->data, data, len);
+    slot->len = (uint16_t) len;
+    slot->valid = true;
+    slot->nacked = false;
+    arq->stats.rx_frames++;
+
+    // cada lacuna antes deste quadro é pedida uma única vez, o temporizador do transmissor cobre o resto
+    for(uint8_t n = 0; n < off; n++)
+    {
+        utl_arq_rx_slot_t* hole = &arq->rx[ARQ_SLOT(arq->rx_base + n)];
+        if(!hole->valid && !hole->nacked)
+        {
+            hole->nacked = true;
+            arq_nack_send(arq, (uint8_t) (arq->rx_base + n));
+        }
+    }
+}
+
+static void arq_ack_handle(utl_arq_t* arq, uint8_t cum, uint32_t sack)
+{
+    uint8_t pending = (uint8_t) (arq->tx_next - arq->tx_base);
+    uint8_t acked = (uint8_t) (cum - arq->tx_base);
+
+    // ACK antigo, chegando depois de um mais recente
+    if(acked > pending)
+        return;
+
+    for(uint8_t n = 0; n < acked; n++)
+        arq->tx[ARQ_SLOT(arq->tx_base + n)].acked = true;
+
+    for(uint8_t n = 0; n < 32 && sack; n++, sack >>= 1)
+    {
+        uint8_t seq = (uint8_t) (cum + 1 + n);
+        if((sack & 1) && (uint8_t) (seq - arq->tx_base) < pending)
+            arq->tx[ARQ_SLOT(seq)].acked = true;
+    }
+
+    while(arq->tx_base != arq->tx_next && arq->tx[ARQ_SLOT(arq->tx_base)].acked)
+        arq->tx_base++;
+}
+
+static void arq_nack_handle(utl_arq_t* arq, uint8_t seq)
+{
+    utl_arq_tx_slot_t* slot = &arq->tx[ARQ_SLOT(seq)];
+
+    arq->stats.nacks_received++;
+    if((uint8_t) (seq - arq->tx_base) < (uint8_t) (arq->tx_next - arq->tx_base) && !slot->acked)
+        arq_retransmit(arq, slot);
+}
+
+static void arq_frame_handle(utl_arq_t* arq, const uint8_t* frame, size_t len)
+{
+    // o CRC é transmitido MSB primeiro, então o CRC do quadro inteiro é zero
+    if(len < UTL_ARQ_HEADER_SIZE + COBS_FRAME_CRC_SIZE ||
+       hal_crc_data(HAL_CRC_CRC16_CCITT, frame, len, 0xFFFF) != 0)
+    {
+        arq->stats.rx_errors++;
+        return;
+    }
+
+    len -= UTL_ARQ_HEADER_SIZE + COBS_FRAME_CRC_SIZE;
+    switch(frame[0])
+    {
+    case ARQ_TYPE_DATA:
+        if(len > 0)
+        {
+            arq_data_handle(arq, frame[1], frame + UTL_ARQ_HEADER_SIZE, len);
+            return;
+        }
+        break;
+    case ARQ_TYPE_ACK:
+        if(len == ARQ_ACK_SIZE - UTL_ARQ_HEADER_SIZE)
+        {
+            arq_ack_handle(arq, frame[1],
+                           (uint32_t) frame[2] | (uint32_t) frame[3] << 8 | (uint32_t) frame[4] << 16 |
+                               (uint32_t) frame[5] << 24);
+            return;
+        }
+        break;
+    case ARQ_TYPE_NACK:
+        if(len == 0)
+        {
+            arq_nack_handle(arq, frame[1]);
+            return;
+        }
+        break;
+    }
+
+    arq->stats.rx_errors++;
+}
+
+utl_arq_status_t utl_arq_init(utl_arq_t* arq, hal_uart_dev_t dev, const utl_arq_config_t* cfg)
+{
+    if(!dev || !cfg || cfg->window == 0 || cfg->window > UTL_ARQ_WINDOW_MAX || cfg->rto_ms == 0)
+        return UTL_ARQ_ERROR;
+
+    memset(arq, 0, sizeof(*arq));
+    arq->dev = dev;
+    arq->cfg = *cfg;
+    cobs_decoder_init(&arq->dec, arq->dec_buf, sizeof(arq->dec_buf));
+
+    return UTL_ARQ_OK;
+}
+
+utl_arq_status_t utl_arq_send(utl_arq_t* arq, const void* data, size_t len)
+{
+    uint8_t msg[UTL_ARQ_HEADER_SIZE + UTL_ARQ_PAYLOAD_MAX];
+    utl_arq_tx_slot_t* slot;
+
+    if(arq->failed || len == 0 || len > UTL_ARQ_PAYLOAD_MAX)
+        return UTL_ARQ_ERROR;
+
+    if((uint8_t) (arq->tx_next - arq->tx_base) >= arq->cfg.window)
+        return UTL_ARQ_BUSY;
+
+    msg[0] = ARQ_TYPE_DATA;
+    msg[1] = arq->tx_next;
+    memcpy(msg + UTL_ARQ_HEADER_SIZE, data, len);
+
+    slot = &arq->tx[ARQ_SLOT(arq->tx_next)];
+    slot->len = (uint16_t) cobs_frame_encode(msg, slot->frame, UTL_ARQ_HEADER_SIZE + len);
+    slot->retries = 0;
+    slot->acked = false;
+    slot->sent_ms = hal_cpu_time_get_ms();
+    arq->tx_next++;
+    arq->stats.tx_frames++;
+
+    arq_write(arq, slot->frame, slot->len);
+
+    return UTL_ARQ_OK;
+}
+
+utl_arq_status_t utl_arq_recv(utl_arq_t* arq, void* data, size_t size, size_t* len)
+{
+    utl_arq_rx_slot_t* slot = &arq->rx[ARQ_SLOT(arq->rx_base)];
+
+    *len = 0;
+    if(!slot->valid)
+        return UTL_ARQ_EMPTY;
+
+    if(slot->len > size)
+        return UTL_ARQ_ERROR;
+
+    memcpy(data, slot->data, slot->len);
+    *len = slot->len;
+    slot->valid = false;
+    slot->nacked = false;
+    arq->rx_base++;
+    // a janela do receptor avançou, o transmissor precisa saber
+    arq->ack_pending = true;
+
+    return UTL_ARQ_OK;
+}
+
+utl_arq_status_t utl_arq_poll(utl_arq_t* arq)
+{
+    uint8_t chunk[ARQ_RX_CHUNK_SIZE];
+    ssize_t n;
+
+    while((n = hal_uart_read(arq->dev, chunk, sizeof(chunk))) > 0)
+    {
+        const uint8_t* ptr = chunk;
+        size_t left = (size_t) n;
+
+        while(left)
+        {
+            size_t used;
+            cobs_decoder_status_t status = cobs_decoder_feed(&arq->dec, ptr, left, &used);
+
+            if(status == COBS_DECODER_FRAME)
+                arq_frame_handle(arq, arq->dec_buf, arq->dec.len);
+            else if(status == COBS_DECODER_ERROR)
+                arq->stats.rx_errors++;
+
+            ptr += used;
+            left -= used;
+        }
+    }
+
+    // um único ACK confirma tudo o que chegou desde a última chamada
+    if(arq->ack_pending)
+        arq_ack_send(arq);
+
+    for(uint8_t seq = arq->tx_base; seq != arq->tx_next; seq++)
+    {
+        utl_arq_tx_slot_t* slot = &arq->tx[ARQ_SLOT(seq)];
+        if(!slot->acked && hal_cpu_time_elapsed_get_ms(slot->sent_ms) >= arq->cfg.rto_ms)
+            arq_retransmit(arq, slot);
+    }
+
+    return arq->failed ? UTL_ARQ_ERROR : UTL_ARQ_OK;
+}
+
+uint8_t utl_arq_tx_pending(utl_arq_t* arq)
+{
+    return (uint8_t) (arq->tx_next - arq->tx_base);
+}
+
+void utl_arq_stats_get(utl_arq_t* arq, utl_arq_stats_t* stats)
+{
+    *stats = arq->stats;
+}
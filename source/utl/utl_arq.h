@@ -0,0 +1,158 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "hal_uart.h"
+#include "utl_cobs.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ Transporte confiável sobre uma UART (ARQ com janela deslizante e repetição seletiva).
+
+ Cada mensagem vira um quadro COBS com CRC16 (@ref cobs_frame_encode) contendo um número de sequência de
+ 8 bits. Até @c window quadros ficam em trânsito ao mesmo tempo, sem esperar a confirmação de cada um, de
+ forma que o enlace continua ocupado mesmo com latência e perdas. O receptor guarda quadros fora de ordem,
+ confirma a sequência acumulada junto com um mapa de bits dos quadros já recebidos depois dela (ACK
+ seletivo) e pede a retransmissão imediata de cada lacuna detectada (NACK). Quadros sem confirmação são
+ retransmitidos após @c rto_ms, medido com @ref hal_cpu_time_get_ms.
+
+ As mensagens são entregues à aplicação em ordem e sem duplicatas por @ref utl_arq_recv. Enquanto a
+ aplicação não as retira, a janela do receptor não avança, o que limita o transmissor (controle de fluxo).
+
+ Os dois lados devem usar a mesma janela e começar juntos (sequências partem de zero em @ref utl_arq_init).
+ Todas as funções de uma instância devem ser chamadas do mesmo contexto, sem callback de interrupção na UART.
+*/
+
+/** @brief Maior janela suportada (potência de 2, até 32 pelo mapa de bits do ACK seletivo) */
+#ifndef UTL_ARQ_WINDOW_MAX
+#define UTL_ARQ_WINDOW_MAX 8
+#endif
+
+/** @brief Maior mensagem transportada em um quadro */
+#ifndef UTL_ARQ_PAYLOAD_MAX
+#define UTL_ARQ_PAYLOAD_MAX 128
+#endif
+
+/** @brief Cabeçalho de cada quadro: tipo e número de sequência */
+#define UTL_ARQ_HEADER_SIZE 2
+
+/** @brief Maior quadro transmitido, já codificado e com delimitador */
+#define UTL_ARQ_FRAME_MAX COBS_FRAME_SIZE(UTL_ARQ_HEADER_SIZE + UTL_ARQ_PAYLOAD_MAX)
+
+typedef enum utl_arq_status_e
+{
+    UTL_ARQ_OK = 0,
+    UTL_ARQ_BUSY,  // janela de transmissão cheia
+    UTL_ARQ_EMPTY, // nenhuma mensagem recebida em ordem
+    UTL_ARQ_ERROR,
+} utl_arq_status_t;
+
+typedef struct utl_arq_config_s
+{
+    uint8_t window;      // quadros em trânsito (1 a UTL_ARQ_WINDOW_MAX), igual nos dois lados
+    uint32_t rto_ms;     // tempo sem confirmação até a retransmissão
+    uint8_t max_retries; // retransmissões de um quadro antes de considerar o enlace perdido (0: sem limite)
+} utl_arq_config_t;
+
+typedef struct utl_arq_stats_s
+{
+    uint32_t tx_frames;      // quadros de dados enviados pela primeira vez
+    uint32_t tx_retransmits; // retransmissões, por tempo ou por NACK
+    uint32_t rx_frames;      // quadros de dados novos recebidos
+    uint32_t rx_duplicates;  // quadros de dados já recebidos antes
+    uint32_t rx_errors;      // quadros descartados por CRC, tamanho ou codificação
+    uint32_t nacks_sent;
+    uint32_t nacks_received;
+} utl_arq_stats_t;
+
+typedef struct utl_arq_tx_slot_s
+{
+    uint8_t frame[UTL_ARQ_FRAME_MAX]; // quadro já codificado, pronto para retransmitir
+    uint16_t len;
+    uint8_t retries;
+    bool acked;
+    uint32_t sent_ms;
+} utl_arq_tx_slot_t;
+
+typedef struct utl_arq_rx_slot_s
+{
+    uint8_t data[UTL_ARQ_PAYLOAD_MAX];
+    uint16_t len;
+    bool valid;
+    bool nacked;
+} utl_arq_rx_slot_t;
+
+typedef struct utl_arq_s
+{
+    hal_uart_dev_t dev;
+    utl_arq_config_t cfg;
+    uint8_t tx_base; // quadro mais antigo sem confirmação
+    uint8_t tx_next; // próximo número de sequência a enviar
+    uint8_t rx_base; // próximo número de sequência a entregar
+    bool ack_pending;
+    bool failed;
+    utl_arq_tx_slot_t tx[UTL_ARQ_WINDOW_MAX];
+    utl_arq_rx_slot_t rx[UTL_ARQ_WINDOW_MAX];
+    cobs_decoder_t dec;
+    uint8_t dec_buf[UTL_ARQ_HEADER_SIZE + UTL_ARQ_PAYLOAD_MAX + COBS_FRAME_CRC_SIZE];
+    utl_arq_stats_t stats;
+} utl_arq_t;
+
+/**
+ @brief Inicializa o transporte sobre uma UART já aberta.
+ @param[in] arq - ponteiro para a instância.
+ @param[in] dev - UART aberta sem @c interrupt_callback.
+ @param[in] cfg - configuração (copiada).
+ @return @c UTL_ARQ_ERROR se @p dev for nulo, a janela for inválida ou @p rto_ms for zero
+*/
+utl_arq_status_t utl_arq_init(utl_arq_t* arq, hal_uart_dev_t dev, const utl_arq_config_t* cfg);
+/**
+ @brief Envia uma mensagem, sem esperar a confirmação.
+ O quadro é transmitido imediatamente e mantido até ser confirmado.
+ @param[in] arq - ponteiro para a instância.
+ @param[in] data - conteúdo da mensagem.
+ @param[in] len - tamanho de @p data (1 a @ref UTL_ARQ_PAYLOAD_MAX).
+ @return @c UTL_ARQ_BUSY se a janela estiver cheia (chame @ref utl_arq_poll e tente de novo), @c UTL_ARQ_ERROR
+ se @p len for inválido ou o enlace tiver sido perdido
+*/
+utl_arq_status_t utl_arq_send(utl_arq_t* arq, const void* data, size_t len);
+/**
+ @brief Retira a próxima mensagem recebida, em ordem.
+ @param[in] arq - ponteiro para a instância.
+ @param[out] data - destino do conteúdo da mensagem.
+ @param[in] size - tamanho de @p data.
+ @param[out] len - tamanho da mensagem retirada.
+ @return @c UTL_ARQ_EMPTY se a próxima mensagem ainda não chegou, @c UTL_ARQ_ERROR se ela não couber em
+ @p data (ela permanece na fila)
+*/
+utl_arq_status_t utl_arq_recv(utl_arq_t* arq, void* data, size_t size, size_t* len);
+/**
+ @brief Processa os bytes recebidos, envia as confirmações e retransmite os quadros vencidos.
+ Deve ser chamada periodicamente, com intervalo bem menor que @c rto_ms.
+ @param[in] arq - ponteiro para a instância.
+ @return @c UTL_ARQ_ERROR se algum quadro excedeu @c max_retries (o enlace é considerado perdido até um novo
+ @ref utl_arq_init)
+*/
+utl_arq_status_t utl_arq_poll(utl_arq_t* arq);
+/**
+ @brief Quadros enviados que ainda aguardam confirmação.
+ @param[in] arq - ponteiro para a instância.
+ @return número de quadros em trânsito (zero quando tudo foi entregue)
+*/
+uint8_t utl_arq_tx_pending(utl_arq_t* arq);
+/**
+ @brief Obtém as estatísticas acumuladas desde @ref utl_arq_init.
+ @param[in] arq - ponteiro para a instância.
+ @param[out] stats - destino das estatísticas.
+*/
+void utl_arq_stats_get(utl_arq_t* arq, utl_arq_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,55 +1,650 @@
+// syscall(), clock_gettime() e memfd_create() quando compilado com -std=c11
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "utl_cbf.h"
 
-#define CBF_INC(v, mv) ((((v) + 1) >= (mv)) ? 0 : (v) + 1)
+#if UTL_CBF_WAIT_ENABLED
+#include <time.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+#if UTL_CBF_MIRROR_ENABLED
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+// bits de utl_cbf_t::waiting
+#define CBF_WAITING_DATA 0x01  // consumidor aguardando dados (dorme em prod)
+#define CBF_WAITING_SPACE 0x02 // produtor aguardando espaço (dorme em cons)
+
+#if UTL_CBF_WAIT_ENABLED
+uint64_t utl_cbf_time_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+#if defined(__linux__)
+static void cbf_os_wait(_Atomic uint32_t* idx, uint32_t expected, uint32_t timeout_ms)
+{
+    struct timespec ts = {.tv_sec = timeout_ms / 1000, .tv_nsec = (long) (timeout_ms % 1000) * 1000000L};
+
+    // o kernel compara *idx com expected atomicamente antes de dormir
+    syscall(SYS_futex, (uint32_t*) idx, FUTEX_WAIT_PRIVATE, expected,
+            timeout_ms == UTL_CBF_WAIT_FOREVER ? NULL : &ts, NULL, 0);
+}
 
-utl_cbf_status_t utl_cbf_init(utl_cbf_t* cb, uint8_t* area, uint16_t size)
+static void cbf_os_wake(_Atomic uint32_t* idx)
 {
+    // SPSC: no máximo um lado dorme em cada índice
+    syscall(SYS_futex, (uint32_t*) idx, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+#else
+// sem futex: uma única variável de condição compartilhada por todos os buffers (acordar é raro)
+static pthread_mutex_t cbf_wait_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cbf_wait_cond = PTHREAD_COND_INITIALIZER;
+
+static void cbf_os_wait(_Atomic uint32_t* idx, uint32_t expected, uint32_t timeout_ms)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long) (timeout_ms % 1000) * 1000000L;
+    if(ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&cbf_wait_mutex);
+    if(atomic_load_explicit(idx, memory_order_acquire) == expected)
+    {
+        if(timeout_ms == UTL_CBF_WAIT_FOREVER)
+            pthread_cond_wait(&cbf_wait_cond, &cbf_wait_mutex);
+        else
+            pthread_cond_timedwait(&cbf_wait_cond, &cbf_wait_mutex, &ts);
+    }
+    pthread_mutex_unlock(&cbf_wait_mutex);
+}
+
+static void cbf_os_wake(_Atomic uint32_t* idx)
+{
+    (void) idx;
+
+    pthread_mutex_lock(&cbf_wait_mutex);
+    pthread_cond_broadcast(&cbf_wait_cond);
+    pthread_mutex_unlock(&cbf_wait_mutex);
+}
+#endif
+
+bool utl_cbf_wait_idx(_Atomic uint32_t* waiting, uint32_t side, _Atomic uint32_t* idx, uint32_t expected,
+                      uint64_t start, uint32_t timeout_ms)
+{
+    uint32_t remaining = UTL_CBF_WAIT_FOREVER;
+
+    if(timeout_ms != UTL_CBF_WAIT_FOREVER)
+    {
+        uint64_t elapsed = utl_cbf_time_ms() - start;
+        if(elapsed >= timeout_ms)
+            return false;
+        remaining = timeout_ms - (uint32_t) elapsed;
+    }
+
+    // pareado com a barreira de cbf_wake_idx: ou o outro lado vê o flag ou aqui vemos o índice novo
+    atomic_fetch_or_explicit(waiting, side, memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(idx, memory_order_relaxed) == expected)
+        cbf_os_wait(idx, expected, remaining);
+    atomic_fetch_and_explicit(waiting, ~side, memory_order_relaxed);
+
+    return true;
+}
+
+static inline void cbf_wake_idx(_Atomic uint32_t* waiting, uint32_t side, _Atomic uint32_t* idx)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(waiting, memory_order_relaxed) & side)
+        cbf_os_wake(idx);
+}
+
+void utl_cbf_wake_idx(_Atomic uint32_t* waiting, uint32_t side, _Atomic uint32_t* idx)
+{
+    cbf_wake_idx(waiting, side, idx);
+}
+#endif
+
+// acorda o outro lado, se ele estiver dormindo numa função de espera, após a publicação de idx
+static inline void cbf_wake(utl_cbf_t* cb, _Atomic uint32_t* idx, uint32_t side)
+{
+#if UTL_CBF_WAIT_ENABLED
+    // buffers sem utl_cbf_wait_set nunca têm ninguém dormindo e dispensam a barreira
+    if(!cb->wait)
+        return;
+    cbf_wake_idx(&cb->waiting, side, idx);
+#else
+    (void) cb;
+    (void) idx;
+    (void) side;
+#endif
+}
+
+// publica os dados até prod e acorda o consumidor
+static inline void cbf_publish(utl_cbf_t* cb, uint32_t prod)
+{
+    atomic_store_explicit(&cb->prod, prod, memory_order_release);
+    cbf_wake(cb, &cb->prod, CBF_WAITING_DATA);
+}
+
+// atualiza a marca de ocupação máxima. Só é chamada logo após a leitura do índice do outro lado, cuja linha
+// de cache contém high_water; a escrita (CAS, pois os dois lados amostram) só acontece quando a marca cresce.
+static inline void cbf_high_water(utl_cbf_t* cb, uint32_t used)
+{
+#if UTL_CBF_STATS_ENABLED
+    uint32_t high_water = atomic_load_explicit(&cb->high_water, memory_order_relaxed);
+
+    while(used > high_water && !atomic_compare_exchange_weak_explicit(&cb->high_water, &high_water, used,
+                                                                      memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+#else
+    (void) cb;
+    (void) used;
+#endif
+}
+
+// só o produtor escreve em dropped, portanto não é preciso um RMW atômico
+static inline void cbf_drop(utl_cbf_t* cb, uint32_t n)
+{
+    uint32_t dropped = atomic_load_explicit(&cb->dropped, memory_order_relaxed);
+    atomic_store_explicit(&cb->dropped, dropped + n, memory_order_relaxed);
+}
+
+// modo de sobrescrita: avança cons até caberem n bytes a partir de prod, descartando os mais antigos.
+// O CAS disputa com o consumidor, que também confirma suas retiradas com CAS.
+static void cbf_make_room(utl_cbf_t* cb, uint32_t prod, uint32_t n)
+{
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+
+    while(prod + n - cons > cb->size)
+    {
+        uint32_t target = prod + n - cb->size;
+        if(atomic_compare_exchange_weak_explicit(&cb->cons, &cons, target, memory_order_acq_rel,
+                                                 memory_order_acquire))
+        {
+            cbf_drop(cb, target - cons);
+            cons = target;
+        }
+    }
+
+    cb->cons_cache = cons;
+}
+
+// cópia para o buffer a partir do índice livre pos, com no máximo dois memcpy
+static inline void cbf_copy_in(utl_cbf_t* cb, uint32_t pos, const uint8_t* src, size_t n)
+{
+    uint32_t first = cb->size - pos;
+
+    if(first >= n || cb->mirrored)
+    {
+        memcpy(&cb->buffer[pos], src, n);
+    }
+    else
+    {
+        memcpy(&cb->buffer[pos], src, first);
+        memcpy(cb->buffer, src + first, n - first);
+    }
+}
+
+// cópia do buffer a partir da posição pos, com no máximo dois memcpy
+static inline void cbf_copy_out(utl_cbf_t* cb, uint32_t pos, uint8_t* dst, size_t n)
+{
+    uint32_t first = cb->size - pos;
+
+    if(first >= n || cb->mirrored)
+    {
+        memcpy(dst, &cb->buffer[pos], n);
+    }
+    else
+    {
+        memcpy(dst, &cb->buffer[pos], first);
+        memcpy(dst + first, cb->buffer, n - first);
+    }
+}
+
+// modo de sobrescrita: o produtor pode mover cons a qualquer momento, então o consumidor lê sempre os
+// dois índices, copia e só então confirma com CAS; se o produtor descartou os dados no meio, repete.
+static utl_cbf_status_t cbf_get_overwrite(utl_cbf_t* cb, uint8_t* c)
+{
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+
+    do
+    {
+        if(cons == atomic_load_explicit(&cb->prod, memory_order_acquire))
+            return UTL_CBF_EMPTY;
+        *c = cb->buffer[cons & cb->mask];
+    } while(!atomic_compare_exchange_weak_explicit(&cb->cons, &cons, cons + 1, memory_order_acq_rel,
+                                                   memory_order_acquire));
+
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
+
+    return UTL_CBF_OK;
+}
+
+static size_t cbf_read_overwrite(utl_cbf_t* cb, uint8_t* dst, size_t n)
+{
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+    uint32_t used;
+    size_t len;
+
+    do
+    {
+        // cons pode ter ficado para trás do produtor: a cópia é limitada ao buffer e descartada pelo CAS
+        used = atomic_load_explicit(&cb->prod, memory_order_acquire) - cons;
+        len = used < n ? used : n;
+        len = len < cb->size ? len : cb->size;
+        if(len == 0)
+            return 0;
+        cbf_copy_out(cb, cons & cb->mask, dst, len);
+    } while(!atomic_compare_exchange_weak_explicit(&cb->cons, &cons, cons + (uint32_t) len,
+                                                   memory_order_acq_rel, memory_order_acquire));
+
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
+
+    return len;
+}
+
+static utl_cbf_status_t cbf_put(utl_cbf_t* cb, uint8_t c, bool count_drop)
+{
+    uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+
+    if(prod - cb->cons_cache == cb->size)
+    {
+        cb->cons_cache = atomic_load_explicit(&cb->cons, memory_order_acquire);
+        if(prod - cb->cons_cache == cb->size)
+        {
+            if(cb->overwrite)
+            {
+                cbf_make_room(cb, prod, 1);
+            }
+            else
+            {
+                if(count_drop)
+                    cbf_drop(cb, 1);
+                cbf_high_water(cb, cb->size);
+                return UTL_CBF_FULL;
+            }
+        }
+        cbf_high_water(cb, prod + 1 - cb->cons_cache);
+    }
+
+    cb->buffer[prod & cb->mask] = c;
+    cbf_publish(cb, prod + 1);
+
+    return UTL_CBF_OK;
+}
+
+utl_cbf_status_t utl_cbf_init(utl_cbf_t* cb, uint8_t* area, uint32_t size)
+{
+    if(!UTL_CBF_SIZE_IS_VALID(size))
+        return UTL_CBF_ERROR;
+
     cb->buffer = area;
     cb->size = size;
-    cb->prod = cb->cons = 0;
+    cb->mask = size - 1;
+    cb->mirrored = false;
+    cb->overwrite = false;
+    cb->wait = false;
+    cb->cons_cache = cb->prod_cache = cb->cons_peek = 0;
+    atomic_init(&cb->prod, 0);
+    atomic_init(&cb->cons, 0);
+    atomic_init(&cb->waiting, 0);
+    atomic_init(&cb->dropped, 0);
+    atomic_init(&cb->high_water, 0);
 
     return UTL_CBF_OK;
 }
 
-uint16_t utl_cbf_bytes_available(utl_cbf_t* cb)
+void utl_cbf_overwrite_set(utl_cbf_t* cb, bool enable)
 {
-    if(cb->prod >= cb->cons)
-        return cb->prod - cb->cons;
-    else
-        return cb->prod + (cb->size - cb->cons);
+    cb->overwrite = enable;
+}
+
+void utl_cbf_stats_get(utl_cbf_t* cb, utl_cbf_stats_t* stats)
+{
+    stats->total = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&cb->dropped, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&cb->high_water, memory_order_relaxed);
+}
+
+uint32_t utl_cbf_bytes_available(utl_cbf_t* cb)
+{
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+    uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_acquire);
+
+    // no modo de sobrescrita o produtor pode ter avançado cons entre as duas leituras
+    return prod - cons > cb->size ? cb->size : prod - cons;
 }
 
 utl_cbf_status_t utl_cbf_flush(utl_cbf_t* cb)
 {
-    cb->prod = cb->cons = 0;
+    // o consumidor descarta tudo o que já foi publicado, sem tocar no índice do produtor.
+    // CAS pois no modo de sobrescrita o produtor pode ter avançado cons além do prod lido.
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+    uint32_t prod;
+
+    do
+    {
+        prod = atomic_load_explicit(&cb->prod, memory_order_acquire);
+    } while(!atomic_compare_exchange_weak_explicit(&cb->cons, &cons, prod, memory_order_acq_rel,
+                                                   memory_order_acquire));
+
+    cb->prod_cache = cb->cons_peek = prod;
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
 
     return UTL_CBF_OK;
 }
 
 utl_cbf_status_t utl_cbf_get(utl_cbf_t* cb, uint8_t* c)
 {
-    if(cb->cons == cb->prod)
-        return UTL_CBF_EMPTY;
+    if(cb->overwrite)
+        return cbf_get_overwrite(cb, c);
+
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_relaxed);
+
+    if(cons == cb->prod_cache)
+    {
+        cb->prod_cache = atomic_load_explicit(&cb->prod, memory_order_acquire);
+        if(cons == cb->prod_cache)
+            return UTL_CBF_EMPTY;
+        cbf_high_water(cb, cb->prod_cache - cons);
+    }
 
-    *c = cb->buffer[cb->cons];
-    cb->cons = CBF_INC(cb->cons, cb->size);
+    *c = cb->buffer[cons & cb->mask];
+    atomic_store_explicit(&cb->cons, cons + 1, memory_order_release);
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
 
     return UTL_CBF_OK;
 }
 
 utl_cbf_status_t utl_cbf_put(utl_cbf_t* cb, uint8_t c)
 {
-    size_t next_prod = CBF_INC(cb->prod, cb->size);
+    return cbf_put(cb, c, true);
+}
+
+size_t utl_cbf_write(utl_cbf_t* cb, const uint8_t* src, size_t n)
+{
+    uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+    uint32_t free = cb->size - (prod - cb->cons_cache);
+    size_t requested = n;
+
+    // sobrescrita: de um bloco maior que o buffer só sobrevivem os últimos size bytes
+    if(cb->overwrite && n > cb->size)
+    {
+        cbf_drop(cb, (uint32_t) (n - cb->size));
+        src += n - cb->size;
+        n = cb->size;
+    }
+
+    if(free < n)
+    {
+        cb->cons_cache = atomic_load_explicit(&cb->cons, memory_order_acquire);
+        free = cb->size - (prod - cb->cons_cache);
+        if(free < n)
+        {
+            if(cb->overwrite)
+            {
+                cbf_make_room(cb, prod, (uint32_t) n);
+            }
+            else
+            {
+                cbf_drop(cb, (uint32_t) (n - free));
+                n = free;
+            }
+        }
+        cbf_high_water(cb, prod + (uint32_t) n - cb->cons_cache);
+    }
+
+    if(n == 0)
+        return 0;
+
+    cbf_copy_in(cb, prod & cb->mask, src, n);
+    cbf_publish(cb, prod + (uint32_t) n);
+
+    return cb->overwrite ? requested : n;
+}
+
+size_t utl_cbf_read(utl_cbf_t* cb, uint8_t* dst, size_t n)
+{
+    if(cb->overwrite)
+        return cbf_read_overwrite(cb, dst, n);
+
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_relaxed);
+    uint32_t used = cb->prod_cache - cons;
+
+    if(used < n)
+    {
+        cb->prod_cache = atomic_load_explicit(&cb->prod, memory_order_acquire);
+        used = cb->prod_cache - cons;
+        cbf_high_water(cb, used);
+        if(used < n)
+            n = used;
+    }
+
+    if(n == 0)
+        return 0;
 
-    if(next_prod == cb->cons)
+    cbf_copy_out(cb, cons & cb->mask, dst, n);
+
+    atomic_store_explicit(&cb->cons, cons + (uint32_t) n, memory_order_release);
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
+
+    return n;
+}
+
+uint8_t* utl_cbf_write_reserve(utl_cbf_t* cb, size_t* len)
+{
+    uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+    uint32_t pos = prod & cb->mask;
+    uint32_t free;
+
+    cb->cons_cache = atomic_load_explicit(&cb->cons, memory_order_acquire);
+    free = cb->size - (prod - cb->cons_cache);
+    cbf_high_water(cb, cb->size - free);
+
+    // limitado ao fim da área de dados, exceto no buffer espelhado
+    *len = free < cb->size - pos || cb->mirrored ? free : cb->size - pos;
+
+    return *len ? &cb->buffer[pos] : NULL;
+}
+
+utl_cbf_status_t utl_cbf_write_commit(utl_cbf_t* cb, size_t n)
+{
+    uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+
+    if(n > cb->size - (prod - cb->cons_cache))
         return UTL_CBF_FULL;
 
-    cb->buffer[cb->prod] = c;
-    cb->prod = next_prod;
+    cbf_publish(cb, prod + (uint32_t) n);
 
     return UTL_CBF_OK;
 }
+
+const uint8_t* utl_cbf_read_peek(utl_cbf_t* cb, size_t* len)
+{
+    uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_acquire);
+    uint32_t pos = cons & cb->mask;
+    uint32_t used;
+
+    cb->prod_cache = atomic_load_explicit(&cb->prod, memory_order_acquire);
+    cb->cons_peek = cons;
+    used = cb->prod_cache - cons;
+    if(used > cb->size)
+        used = cb->size;
+    cbf_high_water(cb, used);
+
+    // limitado ao fim da área de dados, exceto no buffer espelhado
+    *len = used < cb->size - pos || cb->mirrored ? used : cb->size - pos;
+
+    return *len ? &cb->buffer[pos] : NULL;
+}
+
+utl_cbf_status_t utl_cbf_read_release(utl_cbf_t* cb, size_t n)
+{
+    uint32_t cons = cb->overwrite ? cb->cons_peek : atomic_load_explicit(&cb->cons, memory_order_relaxed);
+
+    if(n > cb->prod_cache - cons)
+        return UTL_CBF_EMPTY;
+
+    if(cb->overwrite)
+    {
+        // falha se o produtor descartou a região entregue por utl_cbf_read_peek
+        if(!atomic_compare_exchange_strong_explicit(&cb->cons, &cons, cons + (uint32_t) n, memory_order_acq_rel,
+                                                    memory_order_acquire))
+            return UTL_CBF_ERROR;
+        cb->cons_peek = cons + (uint32_t) n;
+    }
+    else
+    {
+        atomic_store_explicit(&cb->cons, cons + (uint32_t) n, memory_order_release);
+    }
+    cbf_wake(cb, &cb->cons, CBF_WAITING_SPACE);
+
+    return UTL_CBF_OK;
+}
+
+#if UTL_CBF_MIRROR_ENABLED
+utl_cbf_status_t utl_cbf_mirror_init(utl_cbf_t* cb, uint32_t size)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    uint8_t* area;
+    int fd;
+
+    if(!UTL_CBF_SIZE_IS_VALID(size) || page <= 0 || size % (uint32_t) page)
+        return UTL_CBF_ERROR;
+
+    fd = memfd_create("utl_cbf", MFD_CLOEXEC);
+    if(fd < 0)
+        return UTL_CBF_ERROR;
+
+    if(ftruncate(fd, size) < 0)
+    {
+        close(fd);
+        return UTL_CBF_ERROR;
+    }
+
+    // reserva 2 * size de espaço virtual e mapeia o mesmo arquivo nas duas metades
+    area = mmap(NULL, 2 * (size_t) size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(area == MAP_FAILED)
+    {
+        close(fd);
+        return UTL_CBF_ERROR;
+    }
+
+    if(mmap(area, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+       mmap(area + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(area, 2 * (size_t) size);
+        close(fd);
+        return UTL_CBF_ERROR;
+    }
+
+    // os mapeamentos mantêm o arquivo vivo
+    close(fd);
+
+    utl_cbf_init(cb, area, size);
+    cb->mirrored = true;
+
+    return UTL_CBF_OK;
+}
+
+void utl_cbf_mirror_deinit(utl_cbf_t* cb)
+{
+    if(!cb->mirrored)
+        return;
+
+    munmap(cb->buffer, 2 * (size_t) cb->size);
+    cb->buffer = NULL;
+    cb->mirrored = false;
+}
+#endif
+
+#if UTL_CBF_WAIT_ENABLED
+void utl_cbf_wait_set(utl_cbf_t* cb, bool enable)
+{
+    cb->wait = enable;
+}
+
+utl_cbf_status_t utl_cbf_get_wait(utl_cbf_t* cb, uint8_t* c, uint32_t timeout_ms)
+{
+    uint64_t start = timeout_ms == UTL_CBF_WAIT_FOREVER ? 0 : utl_cbf_time_ms();
+
+    if(!cb->wait)
+        return UTL_CBF_ERROR;
+
+    while(utl_cbf_get(cb, c) != UTL_CBF_OK)
+    {
+        // vazio: prod == cons
+        uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_relaxed);
+        if(!utl_cbf_wait_idx(&cb->waiting, CBF_WAITING_DATA, &cb->prod, cons, start, timeout_ms))
+            return UTL_CBF_TMROUT;
+    }
+
+    return UTL_CBF_OK;
+}
+
+utl_cbf_status_t utl_cbf_put_wait(utl_cbf_t* cb, uint8_t c, uint32_t timeout_ms)
+{
+    uint64_t start = timeout_ms == UTL_CBF_WAIT_FOREVER ? 0 : utl_cbf_time_ms();
+
+    if(!cb->wait)
+        return UTL_CBF_ERROR;
+
+    while(cbf_put(cb, c, false) != UTL_CBF_OK)
+    {
+        // cheio: cons == prod - size
+        uint32_t prod = atomic_load_explicit(&cb->prod, memory_order_relaxed);
+        if(!utl_cbf_wait_idx(&cb->waiting, CBF_WAITING_SPACE, &cb->cons, prod - cb->size, start, timeout_ms))
+        {
+            cbf_drop(cb, 1);
+            return UTL_CBF_TMROUT;
+        }
+    }
+
+    return UTL_CBF_OK;
+}
+
+size_t utl_cbf_read_wait(utl_cbf_t* cb, uint8_t* dst, size_t n, uint32_t timeout_ms)
+{
+    uint64_t start = timeout_ms == UTL_CBF_WAIT_FOREVER ? 0 : utl_cbf_time_ms();
+    size_t len;
+
+    if(n == 0 || !cb->wait)
+        return utl_cbf_read(cb, dst, n);
+
+    while((len = utl_cbf_read(cb, dst, n)) == 0)
+    {
+        uint32_t cons = atomic_load_explicit(&cb->cons, memory_order_relaxed);
+        if(!utl_cbf_wait_idx(&cb->waiting, CBF_WAITING_DATA, &cb->prod, cons, start, timeout_ms))
+            return 0;
+    }
+
+    return len;
+}
+#endif
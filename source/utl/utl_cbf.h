@@ -1,34 +1,161 @@
-
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdalign.h>
+// campos atômicos na forma _Atomic(T), que o <stdatomic.h> do C++23 também aceita
+#include <stdatomic.h>
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/**
+ @brief Tamanho da linha de cache usada para separar os índices do produtor e do consumidor.
+ Em plataformas sem cache (Cortex-M0/M3/M4) basta o alinhamento natural, evitando desperdício de RAM.
+*/
+#ifndef UTL_CBF_CACHE_LINE_SIZE
+#if defined(__APPLE__) && defined(__aarch64__)
+#define UTL_CBF_CACHE_LINE_SIZE 128
+#elif defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#define UTL_CBF_CACHE_LINE_SIZE 64
+#else
+#define UTL_CBF_CACHE_LINE_SIZE 4
+#endif
+#endif
+
+/**
+ @brief Habilita as funções de espera com timeout (@c utl_cbf_*_wait).
+ No Linux o lado que espera dorme num futex sobre o próprio índice do outro lado; nos demais sistemas POSIX
+ é usada uma variável de condição. Em bare-metal fica desabilitado. Mesmo habilitado, só os buffers marcados
+ com @ref utl_cbf_wait_set pagam a barreira e a leitura de @c waiting a cada publicação; os demais mantêm o
+ caminho sem barreiras.
+*/
+#ifndef UTL_CBF_WAIT_ENABLED
+#if defined(__linux__) || defined(__APPLE__)
+#define UTL_CBF_WAIT_ENABLED 1
+#else
+#define UTL_CBF_WAIT_ENABLED 0
+#endif
+#endif
+
+/**
+ @brief Habilita o buffer circular espelhado (@ref utl_cbf_mirror_init), em que as mesmas páginas são
+ mapeadas duas vezes em sequência na memória virtual. Disponível apenas no Linux (memfd + mmap).
+*/
+#ifndef UTL_CBF_MIRROR_ENABLED
+#if defined(__linux__)
+#define UTL_CBF_MIRROR_ENABLED 1
+#else
+#define UTL_CBF_MIRROR_ENABLED 0
+#endif
+#endif
+
+/**
+ @brief Habilita o registro da marca de ocupação máxima (@c high_water) em @ref utl_cbf_stats_get.
+ A ocupação é amostrada apenas quando um lado já está relendo o índice do outro (produtor ao renovar
+ @c cons_cache, consumidor ao renovar @c prod_cache), sem leituras remotas extras no caminho rápido. O valor
+ é portanto um limite inferior, exato quando o buffer chega a encher. O contador de descartes não depende
+ desta opção, pois só é atualizado quando o buffer está cheio.
+*/
+#ifndef UTL_CBF_STATS_ENABLED
+#define UTL_CBF_STATS_ENABLED 1
+#endif
+
+/** @brief Timeout infinito para as funções @c utl_cbf_*_wait */
+#define UTL_CBF_WAIT_FOREVER UINT32_MAX
+
+/** @brief Maior tamanho aceito para um buffer circular (os contadores de 32 bits precisam distinguir cheio de vazio) */
+#define UTL_CBF_MAX_SIZE (UINT32_C(1) << 31)
+
 typedef enum utl_cbf_status_s
 {
     UTL_CBF_OK = 0,
     UTL_CBF_FULL,
     UTL_CBF_EMPTY,
     UTL_CBF_TMROUT,
+    UTL_CBF_ERROR,
 } utl_cbf_status_t;
 
+/**
+ @brief Buffer circular SPSC (um produtor, um consumidor) sem travas.
+
+ O produtor (ex: thread de RX ou interrupção) só escreve em @c prod e o consumidor só escreve em @c cons.
+ A publicação dos dados é feita com semântica release/acquire, o que garante a ordem entre o conteúdo do
+ buffer e os índices mesmo em processadores multi-core. Cada lado fica numa linha de cache própria, junto
+ com uma cópia local do índice do outro lado, evitando false sharing e leituras remotas a cada operação.
+ O ganho sobre uma fila protegida por mutex pode ser medido com test/utl/cbf_bench (campo "queue"): em put/get
+ byte a byte, cerca de 5 a 9 vezes menos tempo por byte.
+
+ O tamanho é sempre uma potência de 2. Os índices são contadores livres de 32 bits (nunca são zerados no
+ retorno do buffer): a posição no buffer é obtida com @c mask e a ocupação é simplesmente @c prod - @c cons,
+ o que permite usar toda a área de dados, sem a posição vazia de separação.
+
+ No modo de sobrescrita (@ref utl_cbf_overwrite_set) o produtor nunca é recusado: ao encher, ele avança
+ @c cons com CAS descartando os bytes mais antigos e o consumidor passa a confirmar cada retirada também
+ com CAS, repetindo a leitura caso os dados tenham sido sobrescritos no meio da cópia.
+*/
 typedef struct utl_cbf_s
 {
-    volatile size_t prod;
-    volatile size_t cons;
-    uint16_t size;
+    // lado do produtor
+    alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) prod;
+    uint32_t cons_cache;
+    // estatísticas: dropped é escrito apenas pelo produtor, high_water pelos dois lados e só quando cresce
+    _Atomic(uint32_t) dropped;
+    _Atomic(uint32_t) high_water;
+    // lado do consumidor
+    alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) cons;
+    uint32_t prod_cache;
+    // valor de cons visto pelo último utl_cbf_read_peek (modo de sobrescrita)
+    uint32_t cons_peek;
+    // somente leitura após a inicialização
+    alignas(UTL_CBF_CACHE_LINE_SIZE) uint32_t size;
+    uint32_t mask;
     uint8_t* buffer;
+    // área mapeada duas vezes: qualquer trecho de até size bytes a partir de buffer[pos] é contíguo
+    bool mirrored;
+    // descarta os bytes mais antigos em vez de recusar novos quando cheio
+    bool overwrite;
+    // aceita as funções de espera: cada publicação ou retirada verifica se o outro lado está dormindo
+    bool wait;
+    // lados dormindo numa função de espera (só é escrito antes e depois de dormir), em linha própria para
+    // não invalidar a linha somente leitura que os dois lados consultam a cada operação
+    alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) waiting;
 } utl_cbf_t;
 
-#define UTL_CBF_DECLARE(name, _size)        \
-    static uint8_t name##buffer[_size + 1]; \
-    static utl_cbf_t name = {               \
-        .prod = 0,                          \
-        .cons = 0,                          \
-        .size = _size + 1,                  \
-        .buffer = (uint8_t*) name##buffer,  \
+/**
+ @brief Estatísticas de uso de um buffer circular, para dimensionamento a partir de dados reais.
+*/
+typedef struct utl_cbf_stats_s
+{
+    uint32_t total;      ///< bytes aceitos pelo produtor (contador livre, retorna a zero após 4 GiB)
+    uint32_t dropped;    ///< bytes perdidos: recusados por buffer cheio ou sobrescritos no modo de sobrescrita
+    uint32_t high_water; ///< maior ocupação amostrada (0 se @ref UTL_CBF_STATS_ENABLED for 0)
+} utl_cbf_stats_t;
+
+/** @brief Verdadeiro se @p v for uma potência de 2 válida como tamanho de buffer circular */
+#define UTL_CBF_SIZE_IS_VALID(v) ((v) > 0 && (v) <= UTL_CBF_MAX_SIZE && (((v) & ((v) - 1)) == 0))
+
+#define UTL_CBF_DECLARE(name, _size)                                                                 \
+    _Static_assert(UTL_CBF_SIZE_IS_VALID(_size), "utl_cbf: size must be a power of 2 (" #name ")"); \
+    static uint8_t name##buffer[_size];                                                             \
+    static utl_cbf_t name = {                                                                       \
+        .prod = 0,                                                                                  \
+        .cons_cache = 0,                                                                            \
+        .cons = 0,                                                                                  \
+        .dropped = 0,                                                                               \
+        .high_water = 0,                                                                            \
+        .prod_cache = 0,                                                                            \
+        .cons_peek = 0,                                                                             \
+        .size = _size,                                                                              \
+        .mask = (_size) - 1,                                                                        \
+        .buffer = (uint8_t*) name##buffer,                                                          \
+        .mirrored = false,                                                                          \
+        .overwrite = false,                                                                         \
+        .wait = false,                                                                              \
+        .waiting = 0,                                                                               \
     }
 
 /**
@@ -36,15 +163,17 @@ typedef struct utl_cbf_s
  @param[in] cb - ponteiro para o buffer circular.
  @return quantidade de bytes disponível para consumo
 */
-uint16_t utl_cbf_bytes_available(utl_cbf_t* cb);
+uint32_t utl_cbf_bytes_available(utl_cbf_t* cb);
 /**
  @brief Esvazia um buffer circular.
+ Descarta todo o conteúdo publicado até o momento. Deve ser chamada pelo lado consumidor.
  @param[in] cb - ponteiro para o buffer circular.
  @return ver @ref cbf_status_s
 */
 utl_cbf_status_t utl_cbf_flush(utl_cbf_t* cb);
 /**
  @brief Retira um byte do buffer circular.
+ Apenas um consumidor pode chamar esta função por buffer.
  @param[in] cb - ponteiro para o buffer circular.
  @param[out] c - ponteiro para o destino do dado (previamente alocado).
  @return ver @ref cbf_status_s
@@ -53,20 +182,179 @@ utl_cbf_status_t utl_cbf_get(utl_cbf_t* cb, uint8_t* c);
 /**
  @brief Reinicializa um buffer circular, caso seja necessário.
  A macro @ref CBF_DECLARE já faz esse papel mas essa função pode ser usada para inicialização de forma
- independente da macro.
+ independente da macro. Não deve ser chamada com produtor ou consumidor em execução.
  @param[in] cb - ponteiro para o buffer circular.
  @param[in] area - buffer previamente alocado que será usado para armazenamento do conteúdo do buffer circular.
- @param[in] size - tamanho da área de dados apontada por @p area.
- @return ver @ref cbf_status_s
+ @param[in] size - tamanho da área de dados apontada por @p area (potência de 2, até @ref UTL_CBF_MAX_SIZE).
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se @p size for inválido)
+*/
+utl_cbf_status_t utl_cbf_init(utl_cbf_t* cb, uint8_t* area, uint32_t size);
+/**
+ @brief Habilita ou desabilita o modo de sobrescrita.
+ Com o modo habilitado, @ref utl_cbf_put, @ref utl_cbf_write e @ref utl_cbf_put_wait nunca falham por buffer
+ cheio: os bytes mais antigos são descartados (e contados em @c dropped) para dar lugar aos novos. Útil para
+ fluxos de telemetria, em que o dado recente importa mais que o antigo. Não deve ser chamada com produtor ou
+ consumidor em execução.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] enable - true para descartar os dados mais antigos quando cheio.
 */
-utl_cbf_status_t utl_cbf_init(utl_cbf_t* cb, uint8_t* area, uint16_t size);
+void utl_cbf_overwrite_set(utl_cbf_t* cb, bool enable);
+/**
+ @brief Lê as estatísticas de uso do buffer circular.
+ Pode ser chamada de qualquer thread; cada campo é lido atomicamente, sem travar produtor ou consumidor.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] stats - destino das estatísticas.
+*/
+void utl_cbf_stats_get(utl_cbf_t* cb, utl_cbf_stats_t* stats);
 /**
  @brief Coloca um byte no buffer circular.
+ Apenas um produtor pode chamar esta função por buffer.
  @param[in] cb - ponteiro para o buffer circular.
  @param[in] c - byte a ser adicionado ao buffer circular.
  @return ver @ref cbf_status_s
 */
 utl_cbf_status_t utl_cbf_put(utl_cbf_t* cb, uint8_t c);
+/**
+ @brief Coloca um bloco de bytes no buffer circular.
+ A cópia é feita com no máximo dois @c memcpy, divididos no ponto de retorno do buffer.
+ Apenas um produtor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] src - dados a serem adicionados.
+ @param[in] n - quantidade de bytes em @p src.
+ @return quantidade de bytes efetivamente escritos (menor que @p n se o buffer encher; no modo de sobrescrita
+ é sempre @p n, mas apenas os últimos @c size bytes são mantidos)
+*/
+size_t utl_cbf_write(utl_cbf_t* cb, const uint8_t* src, size_t n);
+/**
+ @brief Retira um bloco de bytes do buffer circular.
+ A cópia é feita com no máximo dois @c memcpy, divididos no ponto de retorno do buffer.
+ Apenas um consumidor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] dst - destino dos dados (previamente alocado).
+ @param[in] n - quantidade máxima de bytes a ler.
+ @return quantidade de bytes efetivamente lidos
+*/
+size_t utl_cbf_read(utl_cbf_t* cb, uint8_t* dst, size_t n);
+/**
+ @brief Reserva espaço contíguo para escrita direta no buffer circular (zero-copy).
+ O produtor escreve diretamente na área retornada (ex: @c read(fd, ptr, len)) e depois publica os dados
+ com @ref utl_cbf_write_commit. Apenas um produtor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] len - quantidade de bytes contíguos livres a partir do ponteiro retornado.
+ @return ponteiro para a área livre ou NULL se o buffer estiver cheio
+*/
+uint8_t* utl_cbf_write_reserve(utl_cbf_t* cb, size_t* len);
+/**
+ @brief Publica bytes escritos numa área obtida com @ref utl_cbf_write_reserve.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] n - quantidade de bytes escritos (no máximo o tamanho reservado).
+ @return ver @ref cbf_status_s (@c UTL_CBF_FULL se @p n excede o espaço livre)
+*/
+utl_cbf_status_t utl_cbf_write_commit(utl_cbf_t* cb, size_t n);
+/**
+ @brief Obtém acesso direto aos próximos bytes contíguos do buffer circular, sem retirá-los (zero-copy).
+ Os dados permanecem válidos até a chamada de @ref utl_cbf_read_release. Apenas um consumidor pode chamar
+ esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] len - quantidade de bytes contíguos disponíveis a partir do ponteiro retornado.
+ @return ponteiro para os dados ou NULL se o buffer estiver vazio
+*/
+const uint8_t* utl_cbf_read_peek(utl_cbf_t* cb, size_t* len);
+/**
+ @brief Libera bytes consumidos de uma área obtida com @ref utl_cbf_read_peek.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] n - quantidade de bytes consumidos.
+ @return ver @ref cbf_status_s (@c UTL_CBF_EMPTY se @p n excede os bytes disponíveis, @c UTL_CBF_ERROR se
+ no modo de sobrescrita o produtor descartou a região lida antes da liberação; os dados devem ser ignorados)
+*/
+utl_cbf_status_t utl_cbf_read_release(utl_cbf_t* cb, size_t n);
+
+#if UTL_CBF_MIRROR_ENABLED
+/**
+ @brief Inicializa um buffer circular espelhado.
+ A área de dados é criada com @c memfd e mapeada duas vezes, uma logo após a outra. Assim
+ @ref utl_cbf_read_peek e @ref utl_cbf_write_reserve sempre retornam toda a região disponível de forma
+ contígua, mesmo quando ela atravessa o ponto de retorno, e parsers como @c gps_decode ou @c cobs_decode
+ podem trabalhar diretamente sobre o buffer, sem cópias para linearizar os dados.
+ Não deve ser chamada com produtor ou consumidor em execução.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] size - tamanho da área de dados (potência de 2 e múltiplo do tamanho de página).
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se @p size for inválido ou o mapeamento falhar)
+*/
+utl_cbf_status_t utl_cbf_mirror_init(utl_cbf_t* cb, uint32_t size);
+/**
+ @brief Libera os mapeamentos de um buffer circular criado com @ref utl_cbf_mirror_init.
+ @param[in] cb - ponteiro para o buffer circular.
+*/
+void utl_cbf_mirror_deinit(utl_cbf_t* cb);
+#endif
+
+#if UTL_CBF_WAIT_ENABLED
+/**
+ @brief Habilita as funções de espera (@c utl_cbf_*_wait) no buffer circular.
+ Sem esta chamada o produtor e o consumidor não verificam se o outro lado está dormindo, e as funções de
+ espera não bloqueiam: @ref utl_cbf_get_wait e @ref utl_cbf_put_wait retornam @c UTL_CBF_ERROR e
+ @ref utl_cbf_read_wait se comporta como @ref utl_cbf_read. Não deve ser chamada com produtor ou consumidor
+ em execução.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] enable - true para permitir que um dos lados durma esperando pelo outro.
+*/
+void utl_cbf_wait_set(utl_cbf_t* cb, bool enable);
+/**
+ @brief Retira um byte do buffer circular, dormindo até que um dado chegue ou o tempo se esgote.
+ O produtor acorda o consumidor ao publicar, sem necessidade de polling. Apenas um consumidor pode chamar
+ esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] c - ponteiro para o destino do dado (previamente alocado).
+ @param[in] timeout_ms - tempo máximo de espera em ms (ou @ref UTL_CBF_WAIT_FOREVER).
+ @return ver @ref cbf_status_s (@c UTL_CBF_TMROUT se nenhum dado chegou a tempo, @c UTL_CBF_ERROR sem
+ @ref utl_cbf_wait_set)
+*/
+utl_cbf_status_t utl_cbf_get_wait(utl_cbf_t* cb, uint8_t* c, uint32_t timeout_ms);
+/**
+ @brief Coloca um byte no buffer circular, dormindo até que haja espaço ou o tempo se esgote.
+ Apenas um produtor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] c - byte a ser adicionado ao buffer circular.
+ @param[in] timeout_ms - tempo máximo de espera em ms (ou @ref UTL_CBF_WAIT_FOREVER).
+ @return ver @ref cbf_status_s (@c UTL_CBF_TMROUT se o buffer continuou cheio, @c UTL_CBF_ERROR sem
+ @ref utl_cbf_wait_set)
+*/
+utl_cbf_status_t utl_cbf_put_wait(utl_cbf_t* cb, uint8_t c, uint32_t timeout_ms);
+/**
+ @brief Retira um bloco de bytes do buffer circular, dormindo até que ao menos um byte esteja disponível.
+ Apenas um consumidor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] dst - destino dos dados (previamente alocado).
+ @param[in] n - quantidade máxima de bytes a ler.
+ @param[in] timeout_ms - tempo máximo de espera em ms (ou @ref UTL_CBF_WAIT_FOREVER).
+ @return quantidade de bytes lidos (0 se o tempo se esgotou)
+*/
+size_t utl_cbf_read_wait(utl_cbf_t* cb, uint8_t* dst, size_t n, uint32_t timeout_ms);
+/**
+ @brief Relógio monotônico em ms, referência de @p start em @ref utl_cbf_wait_idx.
+*/
+uint64_t utl_cbf_time_ms(void);
+/**
+ @brief Espera das funções @c utl_cbf_*_wait, compartilhada com as demais filas (ex: @ref utl_mpsc_get_wait).
+ Marca @p side em @p waiting e dorme enquanto @p idx valer @p expected. Quem publica um novo valor em @p idx
+ chama @ref utl_cbf_wake_idx em seguida.
+ @param[in] waiting - flags de quem está dormindo na fila.
+ @param[in] side - flag deste lado em @p waiting.
+ @param[in] idx - índice (ou sequência) observado, com 32 bits para servir de futex.
+ @param[in] expected - valor de @p idx que faz a espera continuar.
+ @param[in] start - início da espera (@ref utl_cbf_time_ms).
+ @param[in] timeout_ms - tempo máximo de espera desde @p start (ou @ref UTL_CBF_WAIT_FOREVER).
+ @return false se o tempo já se esgotou, true caso contrário (o chamador verifica a fila de novo)
+*/
+bool utl_cbf_wait_idx(_Atomic(uint32_t)* waiting, uint32_t side, _Atomic(uint32_t)* idx, uint32_t expected,
+                      uint64_t start, uint32_t timeout_ms);
+/**
+ @brief Acorda quem dorme em @ref utl_cbf_wait_idx sobre @p idx, se @p side estiver marcado em @p waiting.
+ Deve ser chamada após a publicação do novo valor de @p idx.
+*/
+void utl_cbf_wake_idx(_Atomic(uint32_t)* waiting, uint32_t side, _Atomic(uint32_t)* idx);
+#endif
 
 #ifdef __cplusplus
 }
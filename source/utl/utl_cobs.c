@@ -1,18 +1,27 @@
 #include "hal.h"
+#include "utl_cobs.h"
+#include "utl_crc16.h"
 
 // ref: https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing
 
-/** COBS encode data to buffer
-    @param input Pointer to input data to encode
-    @param output Pointer to encoded output buffer
-    @param len Number of bytes to encode
-    @return Encoded output len in bytes
-    @note Does not output delimiter byte
-*/
-size_t cobs_encode(const void* input, uint8_t* output, size_t len)
-{
-    assert(input && output);
+// CRC16-CCITT of the frames, acc being the running CRC (0xFFFF to start). A HAL call sets up the CRC unit
+// every time, so with it the CRC is taken once per frame; the table kernel is instead fused with the
+// encode/decode runs, while each run is still in cache.
+#if UTL_COBS_HAL_CRC_ENABLED
+#define COBS_CRC16(data, len, acc) ((uint16_t) hal_crc_data(HAL_CRC_CRC16_CCITT, data, len, acc))
+#define COBS_CRC16_FUSED 0
+#else
+#define COBS_CRC16(data, len, acc) utl_crc16_data(data, len, acc)
+#define COBS_CRC16_FUSED 1
+#endif
+
+#if UTL_COBS_SIMD_ENABLED
+#include <immintrin.h>
+#endif
 
+// Byte-at-a-time encoder, used for short payloads and where there is no vector path
+static size_t cobs_encode_scalar(const void* input, uint8_t* output, size_t len)
+{
     uint8_t* encode = output;  // Encoded byte pointer
     uint8_t* codep = encode++; // Output code pointer
     uint8_t code = 1;          // Code value
@@ -34,17 +43,8 @@ size_t cobs_encode(const void* input, uint8_t* output, size_t len)
     return (size_t) (encode - output);
 }
 
-/** COBS decode data from buffer
-    @param input Pointer to encoded input bytes
-    @param len Number of bytes to decode
-    @param output Pointer to decoded output data
-    @return Number of bytes successfully decoded
-    @note Stops decoding if delimiter byte is found
-*/
-size_t cobs_decode(const uint8_t* input, void* output, size_t len)
+static size_t cobs_decode_scalar(const uint8_t* input, void* output, size_t len)
 {
-    assert(input && output);
-
     const uint8_t* byte = input;         // Encoded input byte pointer
     uint8_t* decode = (uint8_t*) output; // Decoded output byte pointer
 
@@ -64,3 +64,604 @@ size_t cobs_decode(const uint8_t* input, void* output, size_t len)
 
     return (size_t) (decode - (uint8_t*) output);
 }
+
+#if UTL_COBS_SIMD_ENABLED
+typedef size_t (*cobs_zero_scan_t)(const uint8_t* data, size_t len);
+
+// Index of the first zero byte in data, or len if there is none
+static size_t cobs_zero_scan_sse2(const uint8_t* data, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t pos = 0;
+
+    for(; pos + 16 <= len; pos += 16)
+    {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (data + pos)), zero));
+        if(mask)
+            return pos + (size_t) __builtin_ctz((unsigned) mask);
+    }
+    for(; pos < len; pos++)
+    {
+        if(!data[pos])
+            return pos;
+    }
+
+    return len;
+}
+
+__attribute__((target("avx2"))) static size_t cobs_zero_scan_avx2(const uint8_t* data, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t pos = 0;
+
+    for(; pos + 32 <= len; pos += 32)
+    {
+        int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (data + pos)), zero));
+        if(mask)
+            return pos + (size_t) __builtin_ctz((unsigned) mask);
+    }
+
+    return pos + cobs_zero_scan_sse2(data + pos, len - pos);
+}
+
+// Same output as cobs_encode_scalar, but each block (run of up to 254 non-zero bytes) is found with a
+// vector zero scan and copied with a single memcpy
+static size_t cobs_encode_runs(const uint8_t* input, uint8_t* output, size_t len, cobs_zero_scan_t scan)
+{
+    uint8_t* encode = output;  // Encoded byte pointer
+    uint8_t* codep = encode++; // Output code pointer
+    uint8_t code = 1;          // Code value
+
+    while(len)
+    {
+        size_t run = scan(input, len < 254 ? len : 254);
+
+        memcpy(encode, input, run);
+        encode += run, input += run, len -= run;
+        code = (uint8_t) (run + 1);
+
+        if(code == 0xff) // Block completed, restart
+        {
+            *codep = code, code = 1, codep = encode;
+            if(len)
+                ++encode;
+        }
+        else if(len) // Input is zero, restart
+        {
+            *codep = code, code = 1, codep = encode++;
+            input++, len--;
+        }
+    }
+    *codep = code; // Write final code value
+
+    return (size_t) (encode - output);
+}
+
+// Same output as cobs_decode_scalar, copying each block with a single memcpy
+static size_t cobs_decode_runs(const uint8_t* input, void* output, size_t len)
+{
+    const uint8_t* byte = input;         // Encoded input byte pointer
+    const uint8_t* end = input + len;    // End of encoded input
+    uint8_t* decode = (uint8_t*) output; // Decoded output byte pointer
+
+    for(uint8_t code = 0xff; byte < end;)
+    {
+        if(code != 0xff) // Encoded zero, write it
+            *decode++ = 0;
+        code = *byte++; // Next block len
+        if(!code)       // Delimiter code found
+            break;
+
+        size_t run = (size_t) (end - byte) < (size_t) (code - 1) ? (size_t) (end - byte) : (size_t) (code - 1);
+        memcpy(decode, byte, run);
+        decode += run, byte += run;
+    }
+
+    return (size_t) (decode - (uint8_t*) output);
+}
+#endif
+
+/** COBS encode data to buffer
+    @param input Pointer to input data to encode
+    @param output Pointer to encoded output buffer
+    @param len Number of bytes to encode
+    @return Encoded output len in bytes
+    @note Does not output delimiter byte
+*/
+size_t cobs_encode(const void* input, uint8_t* output, size_t len)
+{
+    assert(input && output);
+
+#if UTL_COBS_SIMD_ENABLED
+    if(len >= UTL_COBS_SIMD_MIN_LEN)
+        return cobs_encode_runs((const uint8_t*) input, output, len,
+                                __builtin_cpu_supports("avx2") ? cobs_zero_scan_avx2 : cobs_zero_scan_sse2);
+#endif
+
+    return cobs_encode_scalar(input, output, len);
+}
+
+/** COBS decode data from buffer
+    @param input Pointer to encoded input bytes
+    @param len Number of bytes to decode
+    @param output Pointer to decoded output data
+    @return Number of bytes successfully decoded
+    @note Stops decoding if delimiter byte is found
+*/
+size_t cobs_decode(const uint8_t* input, void* output, size_t len)
+{
+    assert(input && output);
+
+#if UTL_COBS_SIMD_ENABLED
+    if(len >= UTL_COBS_SIMD_MIN_LEN)
+        return cobs_decode_runs(input, output, len);
+#endif
+
+    return cobs_decode_scalar(input, output, len);
+}
+
+// COBS/ZPE code table, see cobs_zpe_encode
+#define ZPE_RUN 0xE0                 // 223 bytes, no zero
+#define ZPE_PAIR 0xE1                // Start of the blocks followed by two zeros
+#define ZPE_PAIR_MAX (0xff - ZPE_PAIR) // Longest block followed by two zeros
+
+static inline size_t zpe_block_len(uint8_t code)
+{
+    return code >= ZPE_PAIR ? (size_t) (code - ZPE_PAIR) : (size_t) (code - 1);
+}
+
+static inline uint8_t zpe_block_zeros(uint8_t code)
+{
+    return code >= ZPE_PAIR ? 2 : code == ZPE_RUN ? 0 : 1;
+}
+
+// Code byte and zeros of a block for the link framing
+#if UTL_COBS_ZPE_ENABLED
+#define COBS_NO_ZERO_CODE ZPE_RUN
+#define COBS_BLOCK_LEN(code) zpe_block_len(code)
+#define COBS_BLOCK_ZEROS(code) zpe_block_zeros(code)
+#else
+#define COBS_NO_ZERO_CODE 0xff
+#define COBS_BLOCK_LEN(code) ((size_t) (code) - 1)
+#define COBS_BLOCK_ZEROS(code) ((code) != 0xff ? 1 : 0)
+#endif
+
+// ZPE encoder state. Input is encoded as if followed by one extra zero, which the decoder drops.
+typedef struct zpe_encoder_s
+{
+    uint8_t* encode; // Encoded byte pointer
+    uint8_t* codep;  // Output code pointer
+    uint8_t run;     // Bytes in the current block
+    bool zero;       // A zero ended the block, the next byte decides between one and two zeros
+} zpe_encoder_t;
+
+static inline void zpe_block_end(zpe_encoder_t* enc, uint8_t code)
+{
+    *enc->codep = code, enc->codep = enc->encode++;
+    enc->run = 0, enc->zero = false;
+}
+
+static void zpe_put(zpe_encoder_t* enc, uint8_t byte)
+{
+    if(enc->zero)
+    {
+        if(!byte) // Zero pair
+        {
+            zpe_block_end(enc, (uint8_t) (ZPE_PAIR + enc->run));
+            return;
+        }
+        zpe_block_end(enc, (uint8_t) (enc->run + 1));
+    }
+
+    if(!byte)
+    {
+        if(enc->run <= ZPE_PAIR_MAX) // Wait for a second zero
+            enc->zero = true;
+        else
+            zpe_block_end(enc, (uint8_t) (enc->run + 1));
+        return;
+    }
+
+    *enc->encode++ = byte;
+    if(++enc->run == ZPE_RUN - 1)
+        zpe_block_end(enc, ZPE_RUN);
+}
+
+static size_t zpe_finish(zpe_encoder_t* enc, uint8_t* output)
+{
+    zpe_put(enc, 0); // Implicit trailing zero
+    if(enc->zero)
+        zpe_block_end(enc, (uint8_t) (enc->run + 1));
+
+    return (size_t) (enc->codep - output); // The code slot reserved for the next block is not used
+}
+
+// Decode up to end or a delimiter. complete is false if the last block was cut short.
+static size_t zpe_decode(const uint8_t* input, const uint8_t* end, uint8_t* output, bool* complete)
+{
+    const uint8_t* byte = input; // Encoded input byte pointer
+    uint8_t* decode = output;    // Decoded output byte pointer
+    uint8_t zeros = 0;           // Zeros ending the previous block, written once another block follows
+
+    *complete = true;
+    while(byte < end && *byte)
+    {
+        uint8_t code = *byte++;
+        size_t run = zpe_block_len(code);
+        const uint8_t* zero = memchr(byte, 0, (size_t) (end - byte) < run ? (size_t) (end - byte) : run);
+
+        memset(decode, 0, zeros);
+        decode += zeros;
+
+        if(zero || (size_t) (end - byte) < run) // Truncated block
+        {
+            run = zero ? (size_t) (zero - byte) : (size_t) (end - byte);
+            memcpy(decode, byte, run);
+            *complete = false;
+            return (size_t) (decode + run - output);
+        }
+
+        memcpy(decode, byte, run);
+        decode += run, byte += run;
+        zeros = zpe_block_zeros(code);
+    }
+
+    if(zeros == 2) // The second zero of the last pair is real, the other one is the implicit trailing zero
+        *decode++ = 0;
+
+    return (size_t) (decode - output);
+}
+
+size_t cobs_zpe_encode(const void* input, uint8_t* output, size_t len)
+{
+    assert((input || !len) && output);
+
+    zpe_encoder_t enc = {.encode = output + 1, .codep = output};
+
+    for(const uint8_t* byte = (const uint8_t*) input; len--; ++byte)
+        zpe_put(&enc, *byte);
+
+    return zpe_finish(&enc, output);
+}
+
+size_t cobs_zpe_decode(const uint8_t* input, void* output, size_t len)
+{
+    assert(input && output);
+
+    bool complete;
+
+    return zpe_decode(input, input + len, (uint8_t*) output, &complete);
+}
+
+// Encoder state carried across input segments
+typedef struct cobs_encoder_s
+{
+    uint8_t* encode; // Encoded byte pointer
+    uint8_t* codep;  // Output code pointer
+    uint8_t code;    // Code value
+    size_t total;    // Bytes left in all segments
+} cobs_encoder_t;
+
+// Encode one segment. Blocks may span segments: code carries over and only the room left in the block
+// is scanned. If crc is given, it is updated over each run while it is still in cache.
+static void cobs_encode_segment(cobs_encoder_t* enc, const uint8_t* byte, size_t len, uint16_t* crc)
+{
+    while(len)
+    {
+        const uint8_t* start = byte;
+        size_t limit = len < (size_t) (0xff - enc->code) ? len : (size_t) (0xff - enc->code);
+        const uint8_t* zero = memchr(byte, 0, limit);
+        size_t run = zero ? (size_t) (zero - byte) : limit;
+
+        memcpy(enc->encode, byte, run);
+        enc->encode += run, byte += run, len -= run, enc->total -= run;
+        enc->code += (uint8_t) run;
+
+        if(enc->code == 0xff) // Block completed, restart
+        {
+            *enc->codep = enc->code, enc->code = 1, enc->codep = enc->encode;
+            if(enc->total)
+                ++enc->encode;
+        }
+        else if(zero) // Input is zero, restart
+        {
+            *enc->codep = enc->code, enc->code = 1, enc->codep = enc->encode++;
+            byte++, len--, enc->total--;
+        }
+
+        if(crc)
+            *crc = COBS_CRC16(start, (size_t) (byte - start), *crc);
+    }
+}
+
+size_t cobs_encodev(const utl_cobs_iovec_t* iov, int iovcnt, uint8_t* output)
+{
+    assert((iov || !iovcnt) && output);
+
+    cobs_encoder_t enc = {.encode = output + 1, .codep = output, .code = 1, .total = 0};
+
+    for(int seg = 0; seg < iovcnt; seg++)
+        enc.total += iov[seg].iov_len;
+
+    for(int seg = 0; seg < iovcnt; seg++)
+        cobs_encode_segment(&enc, (const uint8_t*) iov[seg].iov_base, iov[seg].iov_len, NULL);
+    *enc.codep = enc.code; // Write final code value
+
+    return (size_t) (enc.encode - output);
+}
+
+size_t cobs_frame_encode(const void* input, uint8_t* output, size_t len)
+{
+    assert((input || !len) && output);
+
+#if UTL_COBS_ZPE_ENABLED
+    zpe_encoder_t zpe = {.encode = output + 1, .codep = output};
+    uint16_t zpe_crc = COBS_CRC16((const uint8_t*) input, len, 0xFFFF);
+
+    for(const uint8_t* byte = (const uint8_t*) input; len--; ++byte)
+        zpe_put(&zpe, *byte);
+    zpe_put(&zpe, (uint8_t) (zpe_crc >> 8));
+    zpe_put(&zpe, (uint8_t) zpe_crc);
+
+    size_t zpe_len = zpe_finish(&zpe, output);
+    output[zpe_len++] = 0; // Delimiter
+
+    return zpe_len;
+#else
+    cobs_encoder_t enc = {.encode = output + 1, .codep = output, .code = 1, .total = len + COBS_FRAME_CRC_SIZE};
+#if COBS_CRC16_FUSED
+    uint16_t crc = 0xFFFF;
+
+    cobs_encode_segment(&enc, (const uint8_t*) input, len, &crc);
+#else
+    uint16_t crc = COBS_CRC16((const uint8_t*) input, len, 0xFFFF);
+
+    cobs_encode_segment(&enc, (const uint8_t*) input, len, NULL);
+#endif
+
+    // CRC MSB first: the CRC over payload and CRC is then zero
+    uint8_t tail[COBS_FRAME_CRC_SIZE] = {(uint8_t) (crc >> 8), (uint8_t) crc};
+    cobs_encode_segment(&enc, tail, sizeof(tail), NULL);
+    *enc.codep = enc.code; // Write final code value
+    *enc.encode++ = 0;     // Delimiter
+
+    return (size_t) (enc.encode - output);
+#endif
+}
+
+bool cobs_frame_decode(const uint8_t* input, void* output, size_t len, size_t* out_len)
+{
+    assert(input && output && out_len);
+
+    const uint8_t* end = memchr(input, 0, len); // Frame ends at the delimiter, if present
+    uint8_t* decode = (uint8_t*) output;        // Decoded output byte pointer
+
+    *out_len = 0;
+    if(!end)
+        end = input + len;
+
+#if UTL_COBS_ZPE_ENABLED
+    bool complete;
+    size_t zpe_len = zpe_decode(input, end, decode, &complete);
+
+    // A truncated block could hide corruption: trailing zeros keep a zero CRC residue
+    if(!complete || zpe_len < COBS_FRAME_CRC_SIZE || COBS_CRC16(decode, zpe_len, 0xFFFF))
+        return false;
+
+    *out_len = zpe_len - COBS_FRAME_CRC_SIZE;
+
+    return true;
+#else
+    const uint8_t* byte = input; // Encoded input byte pointer
+    uint16_t crc = 0xFFFF;
+
+    for(uint8_t code = 0xff; byte < end;)
+    {
+#if COBS_CRC16_FUSED
+        uint8_t* run = decode; // Encoded zero and block, CRC updated in a single call
+#endif
+
+        if(code != 0xff) // Encoded zero, write it
+            *decode++ = 0;
+        code = *byte++; // Next block len
+
+        // A truncated block could hide corruption: trailing zeros keep a zero CRC residue
+        if((size_t) (end - byte) < (size_t) (code - 1))
+            return false;
+
+        memmove(decode, byte, code - 1);
+        decode += code - 1, byte += code - 1;
+#if COBS_CRC16_FUSED
+        crc = COBS_CRC16(run, (size_t) (decode - run), crc);
+#endif
+    }
+
+    size_t decoded = (size_t) (decode - (uint8_t*) output);
+#if !COBS_CRC16_FUSED
+    crc = COBS_CRC16((const uint8_t*) output, decoded, crc);
+#endif
+    if(decoded < COBS_FRAME_CRC_SIZE || crc)
+        return false;
+
+    *out_len = decoded - COBS_FRAME_CRC_SIZE;
+
+    return true;
+#endif
+}
+
+size_t cobs_encode_bounded(const void* input, uint8_t* output, size_t len, size_t out_cap)
+{
+    assert(input && output);
+
+    // Worst case fits, no need to check every byte
+    if(out_cap >= COBS_OVERHEAD_SIZE(len))
+        return cobs_encode(input, output, len);
+
+    if(!out_cap)
+        return 0;
+
+    uint8_t* end = output + out_cap; // End of output buffer
+    uint8_t* encode = output;        // Encoded byte pointer
+    uint8_t* codep = encode++;       // Output code pointer
+    uint8_t code = 1;                // Code value
+
+    for(const uint8_t* byte = (const uint8_t*) input; len--; ++byte)
+    {
+        if(*byte) // Byte not zero, write it
+        {
+            if(encode >= end)
+                return 0;
+            *encode++ = *byte, ++code;
+        }
+
+        if(!*byte || code == 0xff) // Input is zero or block completed, restart
+        {
+            *codep = code, code = 1, codep = encode;
+            if(!*byte || len)
+            {
+                if(encode >= end)
+                    return 0;
+                ++encode;
+            }
+        }
+    }
+    if(codep < end) // Final code is outside the frame when the last block was completed
+        *codep = code;
+
+    return (size_t) (encode - output);
+}
+
+size_t cobs_decode_inplace(uint8_t* buffer, size_t len)
+{
+    assert(buffer);
+
+    const uint8_t* byte = buffer;      // Encoded input byte pointer, always ahead of decode
+    const uint8_t* end = buffer + len; // End of encoded input
+    uint8_t* decode = buffer;          // Decoded output byte pointer
+
+    for(uint8_t code = 0xff; byte < end;)
+    {
+        if(code != 0xff) // Encoded zero, write it
+            *decode++ = 0;
+        code = *byte++; // Next block len
+        if(!code)       // Delimiter code found
+            break;
+
+        size_t run = (size_t) (end - byte) < (size_t) (code - 1) ? (size_t) (end - byte) : (size_t) (code - 1);
+        memmove(decode, byte, run);
+        decode += run, byte += run;
+    }
+
+    return (size_t) (decode - buffer);
+}
+
+void cobs_decoder_init(cobs_decoder_t* dec, void* output, size_t size)
+{
+    assert(dec && output);
+
+    dec->output = (uint8_t*) output;
+    dec->size = size;
+    cobs_decoder_reset(dec);
+}
+
+void cobs_decoder_reset(cobs_decoder_t* dec)
+{
+    dec->len = 0;
+    dec->code = COBS_NO_ZERO_CODE; // No pending zero before the first block
+    dec->block = 0;
+    dec->error = false;
+    dec->done = false;
+}
+
+cobs_decoder_status_t cobs_decoder_put(cobs_decoder_t* dec, uint8_t byte)
+{
+    if(dec->done)
+        cobs_decoder_reset(dec);
+
+    if(!byte) // Delimiter found, restart on the next byte
+    {
+        dec->done = true;
+        // Only a zero pair ends with a real zero, a single one is the implicit trailing zero
+        if(!dec->error && !dec->block && COBS_BLOCK_ZEROS(dec->code) == 2)
+        {
+            if(dec->len >= dec->size)
+                dec->error = true;
+            else
+                dec->output[dec->len++] = 0;
+        }
+        if(dec->error || dec->block) // Overflow or truncated block
+        {
+            dec->len = 0;
+            return COBS_DECODER_ERROR;
+        }
+        return COBS_DECODER_FRAME;
+    }
+
+    if(dec->error)
+        return COBS_DECODER_MORE;
+
+    if(dec->block) // Decode block byte
+    {
+        if(dec->len >= dec->size)
+            dec->error = true;
+        else
+            dec->output[dec->len++] = byte, dec->block--;
+    }
+    else
+    {
+        for(uint8_t zeros = COBS_BLOCK_ZEROS(dec->code); zeros; zeros--) // Encoded zeros, write them
+        {
+            if(dec->len >= dec->size)
+            {
+                dec->error = true;
+                return COBS_DECODER_MORE;
+            }
+            dec->output[dec->len++] = 0;
+        }
+        dec->code = byte; // Next block len
+        dec->block = (uint8_t) COBS_BLOCK_LEN(byte);
+    }
+
+    return COBS_DECODER_MORE;
+}
+
+cobs_decoder_status_t cobs_decoder_feed(cobs_decoder_t* dec, const uint8_t* input, size_t len, size_t* used)
+{
+    assert(dec && input && used);
+
+    const uint8_t* byte = input;
+    const uint8_t* end = input + len;
+
+    while(byte < end)
+    {
+        // Copy whole runs of block bytes at once, stopping at an unexpected delimiter
+        if(dec->block && !dec->error && !dec->done)
+        {
+            size_t run = (size_t) (end - byte) < dec->block ? (size_t) (end - byte) : dec->block;
+            const uint8_t* zero = memchr(byte, 0, run);
+            if(zero)
+                run = (size_t) (zero - byte);
+            if(run > dec->size - dec->len)
+                run = dec->size - dec->len;
+            if(run)
+            {
+                memcpy(dec->output + dec->len, byte, run);
+                dec->len += run;
+                dec->block -= (uint8_t) run;
+                byte += run;
+                continue;
+            }
+        }
+
+        cobs_decoder_status_t status = cobs_decoder_put(dec, *byte++);
+        if(status != COBS_DECODER_MORE)
+        {
+            *used = (size_t) (byte - input);
+            return status;
+        }
+    }
+
+    *used = len;
+
+    return COBS_DECODER_MORE;
+}
@@ -1,12 +1,60 @@
 #pragma once
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/** Buffer segment for scatter-gather functions. Same layout as POSIX @c struct iovec, so an iovec array can be
+    passed with a cast, but with its own name to avoid clashing with lwIP or toolchain definitions.
+*/
+typedef struct utl_cobs_iovec_s
+{
+    void* iov_base; /**< Segment start */
+    size_t iov_len; /**< Segment size in bytes */
+} utl_cobs_iovec_t;
+
+/** Vector path for bulk payloads: blocks are found with an SSE2/AVX2 zero scan (picked at runtime) and copied
+    with memcpy. Output is identical to the byte-at-a-time path, which stays as the fallback.
+*/
+#ifndef UTL_COBS_SIMD_ENABLED
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define UTL_COBS_SIMD_ENABLED 1
+#else
+#define UTL_COBS_SIMD_ENABLED 0
+#endif
+#endif
+
+/** Payloads shorter than this are always handled by the byte-at-a-time path */
+#ifndef UTL_COBS_SIMD_MIN_LEN
+#define UTL_COBS_SIMD_MIN_LEN 64
+#endif
+
+/** Link framing (cobs_frame_encode, cobs_frame_decode and the streaming decoder) uses COBS/ZPE instead of
+    plain COBS. Both ends of a link must be built with the same setting.
+*/
+#ifndef UTL_COBS_ZPE_ENABLED
+#define UTL_COBS_ZPE_ENABLED 0
+#endif
+
+/** Frame CRC computed through hal_crc, for ports with a CRC unit (ex: STM32). Only worth it with hardware: the
+    CRC then becomes a separate pass over the payload, where the default (0) folds the utl_crc16 kernel into the
+    encode/decode runs and touches each byte once. When enabled, every user of utl_cobs.c (cobs_encode and
+    cobs_decode included) must link hal_crc.c, the port's port_crc.c, utl_crc.c and utl_crc32c.c, and call
+    hal_crc_init() (done by hal_init) before the first frame.
+*/
+#ifndef UTL_COBS_HAL_CRC_ENABLED
+#define UTL_COBS_HAL_CRC_ENABLED 0
+#endif
+
 #define COBS_OVERHEAD_SIZE(max_len) ((max_len) + ((max_len) / 254) + 1)
 #define COBS_MAX_DATA_LEN(encoded_len) ((encoded_len) - 2 - ((encoded_len - 1) / 255))
+/** Worst case cobs_zpe_encode output for @p max_len bytes (long runs without zeros cost one byte per 223) */
+#define COBS_ZPE_OVERHEAD_SIZE(max_len) ((max_len) + ((max_len) / 223) + 1)
 
 /** COBS encode data to buffer
     @param input Pointer to input data to encode
@@ -26,6 +74,145 @@ size_t cobs_encode(const void* input, uint8_t* output, size_t len);
 */
 size_t cobs_decode(const uint8_t* input, void* output, size_t len);
 
+/** COBS/ZPE (zero pair elimination) encode data to buffer
+    Same framing rules as COBS (no 0x00 in the output), with a different code table: 0x01-0xDF is a block
+    of code - 1 bytes followed by a zero, 0xE0 is 223 bytes without a zero and 0xE1-0xFF is a block of
+    code - 0xE1 bytes (up to 30) followed by two zeros. Zero-heavy payloads (ex: small integers in wide
+    fields) usually come out smaller than the input, where plain COBS always adds at least one byte.
+    @param input Pointer to input data to encode
+    @param output Pointer to encoded output buffer (COBS_ZPE_OVERHEAD_SIZE(len) bytes)
+    @param len Number of bytes to encode
+    @return Encoded output len in bytes
+    @note Does not output delimiter byte
+*/
+size_t cobs_zpe_encode(const void* input, uint8_t* output, size_t len);
+
+/** COBS/ZPE decode data from buffer
+    @param input Pointer to encoded input bytes
+    @param output Pointer to decoded output data. A code byte may expand to two zeros, so unlike
+    cobs_decode_inplace it must not overlap @p input.
+    @param len Number of bytes to decode
+    @return Number of bytes successfully decoded
+    @note Stops decoding if delimiter byte is found
+*/
+size_t cobs_zpe_decode(const uint8_t* input, void* output, size_t len);
+
+/** COBS encode data spread over several segments to buffer
+    Produces the same output as cobs_encode over the concatenation of all segments (ex: header, payload
+    and CRC), in a single pass and without an intermediate copy.
+    @param iov Array of input segments
+    @param iovcnt Number of segments in @p iov
+    @param output Pointer to encoded output buffer (COBS_OVERHEAD_SIZE of the total length)
+    @return Encoded output len in bytes
+    @note Does not output delimiter byte
+*/
+size_t cobs_encodev(const utl_cobs_iovec_t* iov, int iovcnt, uint8_t* output);
+
+/** Size of the CRC16 appended to the payload by cobs_frame_encode */
+#define COBS_FRAME_CRC_SIZE 2
+/** Worst case size of a frame built by cobs_frame_encode for @p len payload bytes, delimiter included */
+#if UTL_COBS_ZPE_ENABLED
+#define COBS_FRAME_SIZE(len) (COBS_ZPE_OVERHEAD_SIZE((len) + COBS_FRAME_CRC_SIZE) + 1)
+#else
+#define COBS_FRAME_SIZE(len) (COBS_OVERHEAD_SIZE((len) + COBS_FRAME_CRC_SIZE) + 1)
+#endif
+
+/** Build a complete frame: COBS(payload + CRC16) + delimiter
+    The CRC16-CCITT (initial value 0xFFFF, same as utl_crc16) is computed while the payload is encoded, so
+    the data is walked only once, and is appended MSB first before the 0x00 delimiter. With
+    UTL_COBS_ZPE_ENABLED the frame is COBS/ZPE encoded instead.
+    @param input Pointer to payload
+    @param output Pointer to frame output buffer (COBS_FRAME_SIZE(len) bytes)
+    @param len Payload size in bytes
+    @return Frame len in bytes, delimiter included
+*/
+size_t cobs_frame_encode(const void* input, uint8_t* output, size_t len);
+
+/** Decode a frame built by cobs_frame_encode and verify its CRC16 while decoding
+    @param input Pointer to frame bytes (the delimiter, if present, ends the frame)
+    @param output Pointer to decoded output, with room for the payload and the CRC. May be equal to
+    @p input to decode in place, except with UTL_COBS_ZPE_ENABLED.
+    @param len Number of frame bytes
+    @param out_len Payload size in bytes (0 if the frame is invalid)
+    @return true if the frame is complete and the CRC matches
+*/
+bool cobs_frame_decode(const uint8_t* input, void* output, size_t len, size_t* out_len);
+
+/** COBS encode data to a buffer of limited size
+    @param input Pointer to input data to encode
+    @param output Pointer to encoded output buffer
+    @param len Number of bytes to encode
+    @param out_cap Size of @p output in bytes
+    @return Encoded output len in bytes, or 0 if it does not fit in @p out_cap (nothing is written past it)
+    @note Does not output delimiter byte. Encoded output is never empty, so 0 always means overflow.
+*/
+size_t cobs_encode_bounded(const void* input, uint8_t* output, size_t len, size_t out_cap);
+
+/** COBS decode data in place
+    Decoded data is never longer than the encoded data, so it overwrites the encoded bytes from the start
+    of @p buffer (ex: a frame inside a RX buffer), without a second allocation.
+    @param buffer Pointer to encoded bytes, replaced by the decoded data
+    @param len Number of bytes to decode
+    @return Number of bytes successfully decoded
+    @note Stops decoding if delimiter byte is found
+*/
+size_t cobs_decode_inplace(uint8_t* buffer, size_t len);
+
+/** Result of feeding bytes to a streaming COBS decoder */
+typedef enum cobs_decoder_status_e
+{
+    COBS_DECODER_MORE = 0, /**< Frame still incomplete, feed more bytes */
+    COBS_DECODER_FRAME,    /**< Delimiter found, @c len bytes of a complete frame are in the output buffer */
+    COBS_DECODER_ERROR,    /**< Delimiter found but the frame was malformed or did not fit, it was discarded */
+} cobs_decoder_status_t;
+
+/** Streaming COBS decoder context
+    Bytes may be fed one at a time (ex: from a UART @c interrupt_callback) or in chunks of any size, without
+    staging the encoded frame. Decoded bytes are written to the output buffer as they arrive. Follows
+    UTL_COBS_ZPE_ENABLED, like the other link framing functions.
+*/
+typedef struct cobs_decoder_s
+{
+    uint8_t* output; /**< Decoded output buffer */
+    size_t size;     /**< Output buffer size */
+    size_t len;      /**< Decoded bytes so far (frame length after @c COBS_DECODER_FRAME) */
+    uint8_t code;    /**< Current block code */
+    uint8_t block;   /**< Bytes left in the current block */
+    bool error;      /**< Frame is being discarded until the next delimiter */
+    bool done;       /**< Last byte was a delimiter, restart on the next one */
+} cobs_decoder_t;
+
+/** Initialize a streaming COBS decoder
+    @param dec Decoder context
+    @param output Buffer for decoded frames
+    @param size Size of @p output, usually COBS_MAX_DATA_LEN of the largest encoded frame
+*/
+void cobs_decoder_init(cobs_decoder_t* dec, void* output, size_t size);
+
+/** Discard any partial frame and wait for the next one
+    @param dec Decoder context
+*/
+void cobs_decoder_reset(cobs_decoder_t* dec);
+
+/** Feed one encoded byte to the decoder
+    @param dec Decoder context
+    @param byte Encoded byte
+    @return Decoder status, see @ref cobs_decoder_status_t
+    @note The output buffer is reused for the next frame, consume it before feeding more bytes
+*/
+cobs_decoder_status_t cobs_decoder_put(cobs_decoder_t* dec, uint8_t byte);
+
+/** Feed a chunk of encoded bytes to the decoder
+    Stops right after the first delimiter so the caller can handle the frame, the remaining bytes
+    must be fed in a following call.
+    @param dec Decoder context
+    @param input Encoded bytes
+    @param len Number of bytes in @p input
+    @param used Number of bytes consumed from @p input
+    @return Decoder status, see @ref cobs_decoder_status_t
+*/
+cobs_decoder_status_t cobs_decoder_feed(cobs_decoder_t* dec, const uint8_t* input, size_t len, size_t* used);
+
 #ifdef __cplusplus
 }
 #endif
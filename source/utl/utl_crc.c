@@ -0,0 +1,223 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "utl_crc.h"
+
+_Static_assert(UTL_CRC_SLICES == 1 || UTL_CRC_SLICES == 4 || UTL_CRC_SLICES == 8, "UTL_CRC_SLICES must be 1, 4 or 8");
+_Static_assert(INT_MAX >= 0x7FFFFFFF, "utl_crc needs 32-bit enum constants");
+
+/*
+ The tables are computed by the compiler from each UTL_CRC_VARIANTS line. A CRC table is linear in the input
+ byte, so tbl[k][b] (CRC of byte b followed by k zero bytes) is the XOR of tbl[k][1 << j] for the bits j set in
+ b, and tbl[k][1 << j] is x^(8k + j) times the polynomial, modulo the polynomial. These 8 * UTL_CRC_SLICES
+ powers are one bit-serial step apart, so each one is an enum constant computed from the previous one: the
+ preprocessor output stays small and the compiler evaluates every step only once.
+
+ The register is left aligned in 32 bits when the variant is not reflected (the top byte is always the next
+ to be folded) and right aligned when it is, so one kernel of each kind serves every width.
+*/
+
+#define CRC_CAT(a, b) CRC_CAT_(a, b)
+#define CRC_CAT_(a, b) a##b
+
+#define CRC_RBIT(v, n) ((((uint32_t) (v) >> (n)) & 1u) << (31 - (n)))
+#define CRC_REFLECT32(v) \
+    (CRC_RBIT(v, 0) | CRC_RBIT(v, 1) | CRC_RBIT(v, 2) | CRC_RBIT(v, 3) | CRC_RBIT(v, 4) | CRC_RBIT(v, 5) | \
+     CRC_RBIT(v, 6) | CRC_RBIT(v, 7) | CRC_RBIT(v, 8) | CRC_RBIT(v, 9) | CRC_RBIT(v, 10) | CRC_RBIT(v, 11) | \
+     CRC_RBIT(v, 12) | CRC_RBIT(v, 13) | CRC_RBIT(v, 14) | CRC_RBIT(v, 15) | CRC_RBIT(v, 16) | CRC_RBIT(v, 17) | \
+     CRC_RBIT(v, 18) | CRC_RBIT(v, 19) | CRC_RBIT(v, 20) | CRC_RBIT(v, 21) | CRC_RBIT(v, 22) | CRC_RBIT(v, 23) | \
+     CRC_RBIT(v, 24) | CRC_RBIT(v, 25) | CRC_RBIT(v, 26) | CRC_RBIT(v, 27) | CRC_RBIT(v, 28) | CRC_RBIT(v, 29) | \
+     CRC_RBIT(v, 30) | CRC_RBIT(v, 31))
+
+// value (poly, init) in register format, r is 0 or 1 (reflected)
+#define CRC_ALIGN(r, w, v) CRC_CAT(CRC_ALIGN_, r)(w, v)
+#define CRC_ALIGN_0(w, v) ((uint32_t) (v) << (32 - (w)))
+#define CRC_ALIGN_1(w, v) (CRC_REFLECT32(v) >> (32 - (w)))
+#define CRC_SHIFT(r, w) CRC_CAT(CRC_SHIFT_, r)(w)
+#define CRC_SHIFT_0(w) (32 - (w))
+#define CRC_SHIFT_1(w) 0
+
+// one bit-serial step (multiplication by x) of register v, with polynomial p
+#define CRC_STEP(r, v, p) CRC_CAT(CRC_STEP_, r)(v, p)
+#define CRC_STEP_0(v, p) (((v) << 1) ^ ((v) >> 31 ? (p) : 0u))
+#define CRC_STEP_1(v, p) (((v) >> 1) ^ ((v) & 1u ? (p) : 0u))
+
+// uint32_t to int without implementation defined conversions, (uint32_t) brings the value back
+#define CRC_INT(v) ((int) ((v) & 0x7FFFFFFFu) - (int) ((v) >> 31) * 0x7FFFFFFF - (int) ((v) >> 31))
+
+#define CRC_POW(name, r, n, m) \
+    crc_##name##_x##n = CRC_INT(CRC_STEP(r, (uint32_t) crc_##name##_x##m, (uint32_t) crc_##name##_x0)),
+
+#define CRC_POWERS_1(name, r) \
+    CRC_POW(name, r, 1, 0) CRC_POW(name, r, 2, 1) CRC_POW(name, r, 3, 2) CRC_POW(name, r, 4, 3) \
+    CRC_POW(name, r, 5, 4) CRC_POW(name, r, 6, 5) CRC_POW(name, r, 7, 6)
+
+#if UTL_CRC_SLICES >= 4
+#define CRC_POWERS_4(name, r) \
+    CRC_POW(name, r, 8, 7) CRC_POW(name, r, 9, 8) CRC_POW(name, r, 10, 9) CRC_POW(name, r, 11, 10) \
+    CRC_POW(name, r, 12, 11) CRC_POW(name, r, 13, 12) CRC_POW(name, r, 14, 13) CRC_POW(name, r, 15, 14) \
+    CRC_POW(name, r, 16, 15) CRC_POW(name, r, 17, 16) CRC_POW(name, r, 18, 17) CRC_POW(name, r, 19, 18) \
+    CRC_POW(name, r, 20, 19) CRC_POW(name, r, 21, 20) CRC_POW(name, r, 22, 21) CRC_POW(name, r, 23, 22) \
+    CRC_POW(name, r, 24, 23) CRC_POW(name, r, 25, 24) CRC_POW(name, r, 26, 25) CRC_POW(name, r, 27, 26) \
+    CRC_POW(name, r, 28, 27) CRC_POW(name, r, 29, 28) CRC_POW(name, r, 30, 29) CRC_POW(name, r, 31, 30)
+#define CRC_ROWS_4(name, r) \
+    {CRC_ROW(name, r, 8, 9, 10, 11, 12, 13, 14, 15)}, {CRC_ROW(name, r, 16, 17, 18, 19, 20, 21, 22, 23)}, \
+        {CRC_ROW(name, r, 24, 25, 26, 27, 28, 29, 30, 31)},
+#else
+#define CRC_POWERS_4(name, r)
+#define CRC_ROWS_4(name, r)
+#endif
+
+#if UTL_CRC_SLICES >= 8
+#define CRC_POWERS_8(name, r) \
+    CRC_POW(name, r, 32, 31) CRC_POW(name, r, 33, 32) CRC_POW(name, r, 34, 33) CRC_POW(name, r, 35, 34) \
+    CRC_POW(name, r, 36, 35) CRC_POW(name, r, 37, 36) CRC_POW(name, r, 38, 37) CRC_POW(name, r, 39, 38) \
+    CRC_POW(name, r, 40, 39) CRC_POW(name, r, 41, 40) CRC_POW(name, r, 42, 41) CRC_POW(name, r, 43, 42) \
+    CRC_POW(name, r, 44, 43) CRC_POW(name, r, 45, 44) CRC_POW(name, r, 46, 45) CRC_POW(name, r, 47, 46) \
+    CRC_POW(name, r, 48, 47) CRC_POW(name, r, 49, 48) CRC_POW(name, r, 50, 49) CRC_POW(name, r, 51, 50) \
+    CRC_POW(name, r, 52, 51) CRC_POW(name, r, 53, 52) CRC_POW(name, r, 54, 53) CRC_POW(name, r, 55, 54) \
+    CRC_POW(name, r, 56, 55) CRC_POW(name, r, 57, 56) CRC_POW(name, r, 58, 57) CRC_POW(name, r, 59, 58) \
+    CRC_POW(name, r, 60, 59) CRC_POW(name, r, 61, 60) CRC_POW(name, r, 62, 61) CRC_POW(name, r, 63, 62)
+#define CRC_ROWS_8(name, r) \
+    {CRC_ROW(name, r, 32, 33, 34, 35, 36, 37, 38, 39)}, {CRC_ROW(name, r, 40, 41, 42, 43, 44, 45, 46, 47)}, \
+        {CRC_ROW(name, r, 48, 49, 50, 51, 52, 53, 54, 55)}, {CRC_ROW(name, r, 56, 57, 58, 59, 60, 61, 62, 63)},
+#else
+#define CRC_POWERS_8(name, r)
+#define CRC_ROWS_8(name, r)
+#endif
+
+// entry for byte b, cN being the entry for the byte with only bit N set
+#define CRC_ENTRY(b, c0, c1, c2, c3, c4, c5, c6, c7) \
+    (((b) & 0x01 ? (uint32_t) c0 : 0u) ^ ((b) & 0x02 ? (uint32_t) c1 : 0u) ^ ((b) & 0x04 ? (uint32_t) c2 : 0u) ^ \
+     ((b) & 0x08 ? (uint32_t) c3 : 0u) ^ ((b) & 0x10 ? (uint32_t) c4 : 0u) ^ ((b) & 0x20 ? (uint32_t) c5 : 0u) ^ \
+     ((b) & 0x40 ? (uint32_t) c6 : 0u) ^ ((b) & 0x80 ? (uint32_t) c7 : 0u))
+
+#define CRC_R16(f, h, ...) \
+    f(0x##h##0, __VA_ARGS__), f(0x##h##1, __VA_ARGS__), f(0x##h##2, __VA_ARGS__), f(0x##h##3, __VA_ARGS__), \
+        f(0x##h##4, __VA_ARGS__), f(0x##h##5, __VA_ARGS__), f(0x##h##6, __VA_ARGS__), f(0x##h##7, __VA_ARGS__), \
+        f(0x##h##8, __VA_ARGS__), f(0x##h##9, __VA_ARGS__), f(0x##h##A, __VA_ARGS__), f(0x##h##B, __VA_ARGS__), \
+        f(0x##h##C, __VA_ARGS__), f(0x##h##D, __VA_ARGS__), f(0x##h##E, __VA_ARGS__), f(0x##h##F, __VA_ARGS__),
+#define CRC_R256(f, ...) \
+    CRC_R16(f, 0, __VA_ARGS__) CRC_R16(f, 1, __VA_ARGS__) CRC_R16(f, 2, __VA_ARGS__) CRC_R16(f, 3, __VA_ARGS__) \
+    CRC_R16(f, 4, __VA_ARGS__) CRC_R16(f, 5, __VA_ARGS__) CRC_R16(f, 6, __VA_ARGS__) CRC_R16(f, 7, __VA_ARGS__) \
+    CRC_R16(f, 8, __VA_ARGS__) CRC_R16(f, 9, __VA_ARGS__) CRC_R16(f, A, __VA_ARGS__) CRC_R16(f, B, __VA_ARGS__) \
+    CRC_R16(f, C, __VA_ARGS__) CRC_R16(f, D, __VA_ARGS__) CRC_R16(f, E, __VA_ARGS__) CRC_R16(f, F, __VA_ARGS__)
+
+// row with the powers x^a .. x^h: bit N of the byte is x^(a + N), or x^(h - N) when reflected
+#define CRC_ROW(name, r, a, b, c, d, e, f, g, h) CRC_CAT(CRC_ROW_, r)(name, a, b, c, d, e, f, g, h)
+#define CRC_ROW_0(name, a, b, c, d, e, f, g, h) \
+    CRC_R256(CRC_ENTRY, crc_##name##_x##a, crc_##name##_x##b, crc_##name##_x##c, crc_##name##_x##d, \
+             crc_##name##_x##e, crc_##name##_x##f, crc_##name##_x##g, crc_##name##_x##h)
+#define CRC_ROW_1(name, a, b, c, d, e, f, g, h) \
+    CRC_R256(CRC_ENTRY, crc_##name##_x##h, crc_##name##_x##g, crc_##name##_x##f, crc_##name##_x##e, \
+             crc_##name##_x##d, crc_##name##_x##c, crc_##name##_x##b, crc_##name##_x##a)
+
+#define CRC_DEFINE(name, w, p, i, r, x) \
+    _Static_assert((w) >= 8 && (w) <= 32, #name ": width must be between 8 and 32"); \
+    _Static_assert(((uint64_t) (p) >> (w)) == 0 && ((uint64_t) (i) >> (w)) == 0 && ((uint64_t) (x) >> (w)) == 0, \
+                   #name ": poly, init and xorout must fit in width bits"); \
+    enum \
+    { \
+        crc_##name##_x0 = CRC_INT(CRC_ALIGN(r, w, p)), \
+        CRC_POWERS_1(name, r) CRC_POWERS_4(name, r) CRC_POWERS_8(name, r) \
+    }; \
+    static const uint32_t crc_##name##_table[UTL_CRC_SLICES][256] = { \
+        {CRC_ROW(name, r, 0, 1, 2, 3, 4, 5, 6, 7)}, CRC_ROWS_4(name, r) CRC_ROWS_8(name, r)}; \
+    const utl_crc_spec_t utl_##name##_spec = { \
+        .table = crc_##name##_table, \
+        .init = CRC_ALIGN(r, w, i), \
+        .xorout = (x), \
+        .width = (w), \
+        .shift = CRC_SHIFT(r, w), \
+        .reflected = (r), \
+    };
+
+UTL_CRC_VARIANTS(CRC_DEFINE)
+
+// MSB first, register left aligned
+static uint32_t crc_update_msb(const uint32_t (*tbl)[256], uint32_t crc, const uint8_t* buffer, size_t size)
+{
+#if UTL_CRC_SLICES >= 8
+    while(size >= 8)
+    {
+        crc = tbl[7][(crc >> 24) ^ buffer[0]] ^ tbl[6][((crc >> 16) ^ buffer[1]) & 0xFF] ^
+              tbl[5][((crc >> 8) ^ buffer[2]) & 0xFF] ^ tbl[4][(crc ^ buffer[3]) & 0xFF] ^ tbl[3][buffer[4]] ^
+              tbl[2][buffer[5]] ^ tbl[1][buffer[6]] ^ tbl[0][buffer[7]];
+        buffer += 8;
+        size -= 8;
+    }
+#endif
+#if UTL_CRC_SLICES >= 4
+    while(size >= 4)
+    {
+        crc = tbl[3][(crc >> 24) ^ buffer[0]] ^ tbl[2][((crc >> 16) ^ buffer[1]) & 0xFF] ^
+              tbl[1][((crc >> 8) ^ buffer[2]) & 0xFF] ^ tbl[0][(crc ^ buffer[3]) & 0xFF];
+        buffer += 4;
+        size -= 4;
+    }
+#endif
+    while(size-- > 0)
+    {
+        crc = (crc << 8) ^ tbl[0][(crc >> 24) ^ *(buffer++)];
+    }
+    return crc;
+}
+
+// LSB first (reflected), register right aligned
+static uint32_t crc_update_lsb(const uint32_t (*tbl)[256], uint32_t crc, const uint8_t* buffer, size_t size)
+{
+#if UTL_CRC_SLICES >= 8
+    while(size >= 8)
+    {
+        crc = tbl[7][(crc ^ buffer[0]) & 0xFF] ^ tbl[6][((crc >> 8) ^ buffer[1]) & 0xFF] ^
+              tbl[5][((crc >> 16) ^ buffer[2]) & 0xFF] ^ tbl[4][(crc >> 24) ^ buffer[3]] ^ tbl[3][buffer[4]] ^
+              tbl[2][buffer[5]] ^ tbl[1][buffer[6]] ^ tbl[0][buffer[7]];
+        buffer += 8;
+        size -= 8;
+    }
+#endif
+#if UTL_CRC_SLICES >= 4
+    while(size >= 4)
+    {
+        crc = tbl[3][(crc ^ buffer[0]) & 0xFF] ^ tbl[2][((crc >> 8) ^ buffer[1]) & 0xFF] ^
+              tbl[1][((crc >> 16) ^ buffer[2]) & 0xFF] ^ tbl[0][(crc >> 24) ^ buffer[3]];
+        buffer += 4;
+        size -= 4;
+    }
+#endif
+    while(size-- > 0)
+    {
+        crc = (crc >> 8) ^ tbl[0][(crc ^ *(buffer++)) & 0xFF];
+    }
+    return crc;
+}
+
+uint32_t utl_crc_init(const utl_crc_spec_t* spec)
+{
+    return spec->init;
+}
+
+uint32_t utl_crc_resume(const utl_crc_spec_t* spec, uint32_t crc)
+{
+    return (crc ^ spec->xorout) << spec->shift;
+}
+
+uint32_t utl_crc_update(const utl_crc_spec_t* spec, uint32_t reg, const uint8_t* data, size_t len)
+{
+    if(spec->reflected)
+        return crc_update_lsb(spec->table, reg, data, len);
+
+    return crc_update_msb(spec->table, reg, data, len);
+}
+
+uint32_t utl_crc_final(const utl_crc_spec_t* spec, uint32_t reg)
+{
+    return (reg >> spec->shift) ^ spec->xorout;
+}
+
+uint32_t utl_crc_data(const utl_crc_spec_t* spec, const uint8_t* data, size_t len)
+{
+    return utl_crc_final(spec, utl_crc_update(spec, utl_crc_init(spec), data, len));
+}
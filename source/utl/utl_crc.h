@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** CRC variants built into utl_crc.c, one line each: X(name, width, poly, init, reflected, xorout)
+    Parameters follow the usual CRC catalogue notation: poly, init and xorout are written MSB first (not
+    reflected), width goes from 8 to 32 and reflected (true or false) applies to both input and output. Each
+    line becomes a utl_<name>_spec object whose slice-by-N tables are computed by the compiler, so there is no
+    table to maintain and nothing to build at runtime. A project may define its own list before including
+    this header, in every translation unit (keep crc32c when utl_crc32c is used).
+*/
+#ifndef UTL_CRC_VARIANTS
+#define UTL_CRC_VARIANTS(X) \
+    /* CRC-8/SMBUS */ \
+    X(crc8, 8, 0x07, 0x00, false, 0x00) \
+    /* CRC-16/CCITT-FALSE, same as utl_crc16 */ \
+    X(crc16_ccitt, 16, 0x1021, 0xFFFF, false, 0x0000) \
+    /* CRC-16/MODBUS (IBM polynomial) */ \
+    X(crc16_modbus, 16, 0x8005, 0xFFFF, true, 0x0000) \
+    /* CRC-24Q (RTCM 3, SBAS) */ \
+    X(crc24q, 24, 0x864CFB, 0x000000, false, 0x000000) \
+    /* CRC-32 (Ethernet, zlib, PNG) */ \
+    X(crc32, 32, 0x04C11DB7, 0xFFFFFFFF, true, 0xFFFFFFFF) \
+    /* CRC-32C (Castagnoli, iSCSI), table fallback of utl_crc32c */ \
+    X(crc32c, 32, 0x1EDC6F41, 0xFFFFFFFF, true, 0xFFFFFFFF)
+#endif
+
+/** Bytes folded per step with slice-by-N tables (1, 4 or 8). Each table costs 1 KiB of flash per variant, and
+    variants that are never referenced are dropped by the linker with -ffunction-sections -fdata-sections and
+    --gc-sections.
+*/
+#ifndef UTL_CRC_SLICES
+#define UTL_CRC_SLICES 8
+#endif
+
+typedef struct utl_crc_spec_s
+{
+    const uint32_t (*table)[256]; // UTL_CRC_SLICES tables, left aligned when not reflected
+    uint32_t init;                // initial value, already in register format
+    uint32_t xorout;
+    uint8_t width;
+    uint8_t shift; // register to result alignment (32 - width when not reflected)
+    bool reflected;
+} utl_crc_spec_t;
+
+#define UTL_CRC_SPEC_DECLARE(name, width, poly, init, reflected, xorout) \
+    extern const utl_crc_spec_t utl_##name##_spec;
+UTL_CRC_VARIANTS(UTL_CRC_SPEC_DECLARE)
+
+/** Register value to start an incremental computation
+    @param spec CRC variant (ex: &utl_crc32_spec)
+    @return Register to be passed to utl_crc_update
+*/
+uint32_t utl_crc_init(const utl_crc_spec_t* spec);
+
+/** Register value to continue an incremental computation after a final CRC value
+    @param spec CRC variant
+    @param crc CRC of the data processed so far, as returned by utl_crc_final or utl_crc_data
+    @return Register to be passed to utl_crc_update
+*/
+uint32_t utl_crc_resume(const utl_crc_spec_t* spec, uint32_t crc);
+
+/** Folds more data into a running register
+    @param spec CRC variant
+    @param reg Register from utl_crc_init or from a previous utl_crc_update
+    @param data Pointer to data
+    @param len Number of bytes
+    @return Updated register
+*/
+uint32_t utl_crc_update(const utl_crc_spec_t* spec, uint32_t reg, const uint8_t* data, size_t len);
+
+/** Final CRC value from a register (output reflection and xorout applied)
+    @param spec CRC variant
+    @param reg Register after the last utl_crc_update
+    @return CRC value, in the low width bits
+*/
+uint32_t utl_crc_final(const utl_crc_spec_t* spec, uint32_t reg);
+
+/** CRC of a whole buffer in one call
+    @param spec CRC variant
+    @param data Pointer to data
+    @param len Number of bytes
+    @return CRC value, in the low width bits
+*/
+uint32_t utl_crc_data(const utl_crc_spec_t* spec, const uint8_t* data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,9 +5,54 @@ extern "C"
 {
 #endif
 
+/** Bytes folded per step with slice-by-N tables (1, 4 or 8). Each extra table costs 512 bytes of flash. */
+#ifndef UTL_CRC16_SLICES
+#define UTL_CRC16_SLICES 8
+#endif
+
+/** Carry-less multiply (PCLMULQDQ) folding for long buffers, picked at runtime when the CPU supports it. The
+    result is identical to the table path, which stays as the fallback.
+*/
+#ifndef UTL_CRC16_CLMUL_ENABLED
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTL_CRC16_CLMUL_ENABLED 1
+#else
+#define UTL_CRC16_CLMUL_ENABLED 0
+#endif
+#endif
+
+/** Buffers shorter than this always use the tables (must be at least 64) */
+#ifndef UTL_CRC16_CLMUL_MIN_LEN
+#define UTL_CRC16_CLMUL_MIN_LEN 256
+#endif
+
 uint16_t utl_crc16_data(const uint8_t* data, size_t len, uint16_t acc);
 
-#define utl_crc16(a, b) utl_crc16_data(a, b, 0xFFFF);
+#define utl_crc16(a, b) utl_crc16_data(a, b, 0xFFFF)
+
+/** Smallest slice handed to each thread by utl_crc16_data_mt, smaller buffers use fewer threads */
+#ifndef UTL_CRC16_MT_MIN_CHUNK
+#define UTL_CRC16_MT_MIN_CHUNK (256u * 1024u)
+#endif
+
+/** CRC of the concatenation A + B from the CRCs of each part, without touching the data
+    @param crc_a CRC of A, with any initial value (ex: a running accumulator)
+    @param crc_b CRC of B computed with utl_crc16 (initial value 0xFFFF)
+    @param len_b Size of B in bytes
+    @return Same value as utl_crc16_data(B, len_b, crc_a)
+*/
+uint16_t utl_crc16_combine(uint16_t crc_a, uint16_t crc_b, size_t len_b);
+
+/** utl_crc16_data split across worker threads, for large buffers (ex: firmware images)
+    Each thread computes the CRC of one slice and the partial results are merged with utl_crc16_combine, so
+    the result is identical to utl_crc16_data. Hosted platforms only (utl_crc16_mt.c, needs pthreads).
+    @param data Pointer to data
+    @param len Number of bytes
+    @param acc Initial value, as in utl_crc16_data
+    @param threads Number of threads, caller included (0: one per online CPU)
+    @return CRC value
+*/
+uint16_t utl_crc16_data_mt(const uint8_t* data, size_t len, uint16_t acc, unsigned threads);
 
 #ifdef __cplusplus
 }
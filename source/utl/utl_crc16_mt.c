@@ -0,0 +1,71 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "utl_crc16.h"
+
+#define CRC16_MT_MAX_THREADS 64
+
+typedef struct crc16_mt_slice_s
+{
+    const uint8_t* data;
+    size_t len;
+    uint16_t crc;
+    pthread_t thread;
+    bool started;
+} crc16_mt_slice_t;
+
+static void* crc16_mt_worker(void* arg)
+{
+    crc16_mt_slice_t* slice = arg;
+
+    slice->crc = utl_crc16_data(slice->data, slice->len, 0xFFFF);
+
+    return NULL;
+}
+
+uint16_t utl_crc16_data_mt(const uint8_t* data, size_t len, uint16_t acc, unsigned threads)
+{
+    crc16_mt_slice_t slices[CRC16_MT_MAX_THREADS];
+    size_t step;
+
+    if(threads == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (unsigned) cpus : 1;
+    }
+    if(threads > CRC16_MT_MAX_THREADS)
+        threads = CRC16_MT_MAX_THREADS;
+    if(threads > len / UTL_CRC16_MT_MIN_CHUNK)
+        threads = (unsigned) (len / UTL_CRC16_MT_MIN_CHUNK);
+    if(threads <= 1)
+        return utl_crc16_data(data, len, acc);
+
+    // Equal slices, the last one also takes the remainder
+    step = len / threads;
+    for(unsigned n = 0; n < threads; n++)
+    {
+        slices[n].data = data + n * step;
+        slices[n].len = n == threads - 1 ? len - n * step : step;
+        slices[n].started = false;
+    }
+
+    // The caller computes the first slice, starting from acc
+    for(unsigned n = 1; n < threads; n++)
+        slices[n].started = pthread_create(&slices[n].thread, NULL, crc16_mt_worker, &slices[n]) == 0;
+
+    acc = utl_crc16_data(slices[0].data, slices[0].len, acc);
+
+    for(unsigned n = 1; n < threads; n++)
+    {
+        if(slices[n].started)
+            pthread_join(slices[n].thread, NULL);
+        else
+            crc16_mt_worker(&slices[n]); // Could not start a thread, compute it here
+        acc = utl_crc16_combine(acc, slices[n].crc, slices[n].len);
+    }
+
+    return acc;
+}
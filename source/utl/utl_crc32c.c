@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "utl_crc.h"
+#include "utl_crc32c.h"
+
+#if UTL_CRC32C_SSE42_ENABLED
+#include <immintrin.h>
+
+// Lane sizes for the three-way interleave: long lanes for bulk data, short ones for what is left
+#define CRC32C_LANE_LONG 2048
+#define CRC32C_LANE_SHORT 256
+
+// x^(8n - 33) mod P (reflected) for a shift over n bytes, P = 0x1EDC6F41
+#define CRC32C_K_LONG_1 0xa51b6135  // n = CRC32C_LANE_LONG
+#define CRC32C_K_LONG_2 0x82f89c77  // n = 2 * CRC32C_LANE_LONG
+#define CRC32C_K_SHORT_1 0xb9e02b86 // n = CRC32C_LANE_SHORT
+#define CRC32C_K_SHORT_2 0xdd7e3b0c // n = 2 * CRC32C_LANE_SHORT
+
+static inline uint64_t crc32c_load(const uint8_t* buffer)
+{
+    uint64_t value;
+    memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+__attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(const uint8_t* buffer, size_t size, uint32_t crc)
+{
+    uint64_t crc64 = crc;
+
+    while(size >= 8)
+    {
+        crc64 = _mm_crc32_u64(crc64, crc32c_load(buffer));
+        buffer += 8;
+        size -= 8;
+    }
+
+    crc = (uint32_t) crc64;
+    while(size-- > 0)
+    {
+        crc = _mm_crc32_u8(crc, *(buffer++));
+    }
+    return crc;
+}
+
+// crc followed by n zero bytes: the carry-less product by x^(8n - 33) is 64 bits long (one extra x from the
+// reflected multiply), and the crc32 instruction reduces it while multiplying by the missing x^32
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t crc32c_shift(uint32_t crc, uint32_t k)
+{
+    __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int) crc), _mm_cvtsi32_si128((int) k), 0x00);
+    return (uint32_t) _mm_crc32_u64(0, (uint64_t) _mm_cvtsi128_si64(prod));
+}
+
+// The instruction has a latency of 3 cycles but accepts one per cycle, so three independent streams over
+// consecutive lanes keep it busy. Each block then ends as crc(lane 0) shifted over two lanes, crc(lane 1)
+// shifted over one and crc(lane 2), the last two starting from zero.
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t crc32c_blocks(const uint8_t** buffer, size_t* size,
+                                                                             uint32_t crc, size_t lane,
+                                                                             uint32_t k1, uint32_t k2)
+{
+    const uint8_t* ptr = *buffer;
+
+    while(*size >= 3 * lane)
+    {
+        uint64_t crc0 = crc;
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+
+        for(size_t pos = 0; pos < lane; pos += 8)
+        {
+            crc0 = _mm_crc32_u64(crc0, crc32c_load(ptr + pos));
+            crc1 = _mm_crc32_u64(crc1, crc32c_load(ptr + lane + pos));
+            crc2 = _mm_crc32_u64(crc2, crc32c_load(ptr + 2 * lane + pos));
+        }
+
+        crc = crc32c_shift((uint32_t) crc0, k2) ^ crc32c_shift((uint32_t) crc1, k1) ^ (uint32_t) crc2;
+        ptr += 3 * lane;
+        *size -= 3 * lane;
+    }
+
+    *buffer = ptr;
+    return crc;
+}
+
+__attribute__((target("sse4.2,pclmul"))) static uint32_t crc32c_3way(const uint8_t* buffer, size_t size,
+                                                                     uint32_t crc)
+{
+    crc = crc32c_blocks(&buffer, &size, crc, CRC32C_LANE_LONG, CRC32C_K_LONG_1, CRC32C_K_LONG_2);
+    crc = crc32c_blocks(&buffer, &size, crc, CRC32C_LANE_SHORT, CRC32C_K_SHORT_1, CRC32C_K_SHORT_2);
+
+    return crc32c_sse42(buffer, size, crc);
+}
+#endif
+
+uint32_t utl_crc32c_data(const uint8_t* buffer, size_t size, uint32_t acc)
+{
+    // the register holds the complement of the result, so a previous result resumes the computation
+    uint32_t crc = ~acc;
+
+#if UTL_CRC32C_SSE42_ENABLED
+    if(__builtin_cpu_supports("sse4.2"))
+    {
+        if(size >= 3 * CRC32C_LANE_SHORT && __builtin_cpu_supports("pclmul"))
+            return ~crc32c_3way(buffer, size, crc);
+        return ~crc32c_sse42(buffer, size, crc);
+    }
+#endif
+
+    return ~utl_crc_update(&utl_crc32c_spec, crc, buffer, size);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** SSE4.2 crc32 instruction for CRC-32C, picked at runtime when the CPU supports it. Long buffers are split in
+    three interleaved streams, merged with PCLMULQDQ, to hide the latency of the instruction. Without SSE4.2 the
+    utl_crc tables (crc32c variant) are used, with identical results.
+*/
+#ifndef UTL_CRC32C_SSE42_ENABLED
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTL_CRC32C_SSE42_ENABLED 1
+#else
+#define UTL_CRC32C_SSE42_ENABLED 0
+#endif
+#endif
+
+/** CRC-32C (Castagnoli, iSCSI/ext4/SCTP), for bulk integrity checks (ex: logs, flash images)
+    @param data Pointer to data
+    @param len Number of bytes
+    @param acc 0 to start, or the result of a previous call to continue over the next part of the data
+    @return CRC value
+*/
+uint32_t utl_crc32c_data(const uint8_t* data, size_t len, uint32_t acc);
+
+#define utl_crc32c(a, b) utl_crc32c_data(a, b, 0)
+
+#ifdef __cplusplus
+}
+#endif
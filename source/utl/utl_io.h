@@ -14,6 +14,10 @@ Notação:
 - [f|t][b|l] = from/to big/little
 - ap[r] = realiza a adição do ponteiro [reference] ao final da operação
 
+Todas as funções são static inline. Com GCC/Clang, cada acesso vira uma única leitura ou escrita (via memcpy,
+que o compilador resolve conforme as regras de alinhamento do alvo) seguida de __builtin_bswap* quando a
+ordem pedida não é a da CPU. Nos demais compiladores o valor é montado byte a byte.
+
 Exemplos:
 
 - utl_io_get16fb()
@@ -25,6 +29,9 @@ Exemplos:
 
 #pragma once
 
+#include <stdint.h>
+#include <string.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -36,6 +43,33 @@ extern "C"
 /** Número de elementos em um array */
 #define HAL_IO_ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
 
+/** Usa __builtin_bswap* e a ordem de bytes do compilador (0 força a montagem byte a byte) */
+#ifndef UTL_IO_BUILTIN_ENABLED
+#if defined(__GNUC__) && defined(__BYTE_ORDER__)
+#define UTL_IO_BUILTIN_ENABLED 1
+#else
+#define UTL_IO_BUILTIN_ENABLED 0
+#endif
+#endif
+
+#if UTL_IO_BUILTIN_ENABLED
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define UTL_IO_LE16(v) (v)
+#define UTL_IO_LE32(v) (v)
+#define UTL_IO_LE64(v) (v)
+#define UTL_IO_BE16(v) __builtin_bswap16(v)
+#define UTL_IO_BE32(v) __builtin_bswap32(v)
+#define UTL_IO_BE64(v) __builtin_bswap64(v)
+#else
+#define UTL_IO_LE16(v) __builtin_bswap16(v)
+#define UTL_IO_LE32(v) __builtin_bswap32(v)
+#define UTL_IO_LE64(v) __builtin_bswap64(v)
+#define UTL_IO_BE16(v) (v)
+#define UTL_IO_BE32(v) (v)
+#define UTL_IO_BE64(v) (v)
+#endif
+#endif
+
 /**
   @name Funções de inversão da ordem de bytes dentro de um tipo de dado (swap).
   @{
@@ -46,77 +80,312 @@ extern "C"
   @param[in] usShort inteiro de 16 bits sem sinal a ser invertido
   @return inteiro de 16 bits sem sinal invertido
  */
-uint16_t utl_io_swap16(uint16_t usShort);
+static inline uint16_t utl_io_swap16(uint16_t usShort)
+{
+#if UTL_IO_BUILTIN_ENABLED
+    return __builtin_bswap16(usShort);
+#else
+    return (uint16_t) (((usShort & 0x00FF) << 8) | ((usShort & 0xFF00) >> 8));
+#endif
+}
 
 /**
   Inverte um inteiro de 32 bits sem sinal.
   @param[in] ulLong inteiro de 32 bits sem sinal a ser invertido
   @return inteiro de 32 bits sem sinal invertido
  */
-uint32_t utl_io_swap32(uint32_t ulLong);
+static inline uint32_t utl_io_swap32(uint32_t ulLong)
+{
+#if UTL_IO_BUILTIN_ENABLED
+    return __builtin_bswap32(ulLong);
+#else
+    return ((ulLong & 0x000000FF) << 24) | ((ulLong & 0x0000FF00) << 8) | ((ulLong & 0x00FF0000) >> 8) |
+           ((ulLong & 0xFF000000) >> 24);
+#endif
+}
 
 /**
   Inverte um inteiro de 16 bits sem sinal dentro de um buffer.
   @param[in,out] pucPtr ponteiro para o buffer onde está o inteiro de 16 bits sem sinal a ser invertido
 */
-void utl_io_swap16p(uint8_t* pucPtr);
+static inline void utl_io_swap16p(uint8_t* pucPtr)
+{
+    uint16_t value;
+    memcpy(&value, pucPtr, sizeof(value));
+    value = utl_io_swap16(value);
+    memcpy(pucPtr, &value, sizeof(value));
+}
 
 /**
   Inverte um inteiro de 32 bits sem sinal dentro de um buffer.
   @param[in,out] pucPtr ponteiro para o buffer onde está o inteiro de 32 bits sem sinal a ser invertido
 */
-void utl_io_swap32p(uint8_t* pucPtr);
+static inline void utl_io_swap32p(uint8_t* pucPtr)
+{
+    uint32_t value;
+    memcpy(&value, pucPtr, sizeof(value));
+    value = utl_io_swap32(value);
+    memcpy(pucPtr, &value, sizeof(value));
+}
 
 /**
   Troca os bits dentro de um byte.
   @param[in,out] ucChar ponteiro para o buffer onde está o byte cujos bits serão invertidos
 */
-uint8_t utl_io_swap8b(uint8_t ucChar);
+static inline uint8_t utl_io_swap8b(uint8_t ucChar)
+{
+    return (uint8_t) (((ucChar & 0x01) << 7) | ((ucChar & 0x02) << 5) | ((ucChar & 0x04) << 3) |
+                      ((ucChar & 0x08) << 1) | ((ucChar & 0x10) >> 1) | ((ucChar & 0x20) >> 3) |
+                      ((ucChar & 0x40) >> 5) | ((ucChar & 0x80) >> 7));
+}
 /** @} */
 
 /**
   @name Funções dependentes de alinhamento (GET)
   @{
 */
-uint8_t utl_io_get8_fl(uint8_t* buf);               /**< Pega um uint8_t usando little endian */
-uint8_t utl_io_get8_fb(uint8_t* buf);               /**< Pega um uint8_t usando big endian */
-uint8_t utl_io_get8_fl_apr(uint8_t** buf);          /**< Pega um uint8_t usando little endian e adiciona o ponteiro */
-uint8_t utl_io_get8_fb_apr(uint8_t** buf);          /**< Pega um uint8_t usando big endian e adiciona o ponteiro */
+
+/** Pega um uint8_t usando little endian */
+static inline uint8_t utl_io_get8_fl(uint8_t* buf)
+{
+    return buf[0];
+}
+
+/** Pega um uint8_t usando big endian */
+static inline uint8_t utl_io_get8_fb(uint8_t* buf)
+{
+    return buf[0];
+}
+
+#if UTL_IO_BUILTIN_ENABLED
+/** Pega um uint16_t usando little endian */
+static inline uint16_t utl_io_get16_fl(uint8_t* buf)
+{
+    uint16_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_LE16(value);
+}
+
+/** Pega um uint16_t usando big endian */
+static inline uint16_t utl_io_get16_fb(uint8_t* buf)
+{
+    uint16_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_BE16(value);
+}
+
+/** Pega um uint32_t usando little endian */
+static inline uint32_t utl_io_get32_fl(uint8_t* buf)
+{
+    uint32_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_LE32(value);
+}
+
+/** Pega um uint32_t usando big endian */
+static inline uint32_t utl_io_get32_fb(uint8_t* buf)
+{
+    uint32_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_BE32(value);
+}
+
+/** Pega um uint64_t usando little endian */
+static inline uint64_t utl_io_get64_fl(uint8_t* buf)
+{
+    uint64_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_LE64(value);
+}
+
+/** Pega um uint64_t usando big endian */
+static inline uint64_t utl_io_get64_fb(uint8_t* buf)
+{
+    uint64_t value;
+    memcpy(&value, buf, sizeof(value));
+    return UTL_IO_BE64(value);
+}
+#else
+/** Pega um uint16_t usando little endian */
+static inline uint16_t utl_io_get16_fl(uint8_t* buf)
+{
+    return (uint16_t) (buf[0] | (buf[1] << 8));
+}
+
+/** Pega um uint16_t usando big endian */
+static inline uint16_t utl_io_get16_fb(uint8_t* buf)
+{
+    return (uint16_t) (buf[1] | (buf[0] << 8));
+}
+
+/** Pega um uint32_t usando little endian */
+static inline uint32_t utl_io_get32_fl(uint8_t* buf)
+{
+    return ((uint32_t) buf[0]) | (((uint32_t) buf[1]) << 8) | (((uint32_t) buf[2]) << 16) |
+           (((uint32_t) buf[3]) << 24);
+}
+
+/** Pega um uint32_t usando big endian */
+static inline uint32_t utl_io_get32_fb(uint8_t* buf)
+{
+    return ((uint32_t) buf[3]) | (((uint32_t) buf[2]) << 8) | (((uint32_t) buf[1]) << 16) |
+           (((uint32_t) buf[0]) << 24);
+}
+
+/** Pega um uint64_t usando little endian */
+static inline uint64_t utl_io_get64_fl(uint8_t* buf)
+{
+    return (((uint64_t) utl_io_get32_fl(buf + 4)) << 32) | utl_io_get32_fl(buf);
+}
+
+/** Pega um uint64_t usando big endian */
+static inline uint64_t utl_io_get64_fb(uint8_t* buf)
+{
+    return (((uint64_t) utl_io_get32_fb(buf)) << 32) | utl_io_get32_fb(buf + 4);
+}
+#endif
+
+/** Pega um float usando little endian */
+static inline float utl_io_getf_fl(uint8_t* src_ptr)
+{
+    uint32_t value = utl_io_get32_fl(src_ptr);
+    float ret;
+    memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+/** Pega um float usando big endian */
+static inline float utl_io_getf_fb(uint8_t* src_ptr)
+{
+    uint32_t value = utl_io_get32_fb(src_ptr);
+    float ret;
+    memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+/** Pega um double usando little endian */
+static inline double utl_io_getd_fl(uint8_t* src_ptr)
+{
+    uint64_t value = utl_io_get64_fl(src_ptr);
+    double ret;
+    memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+/** Pega um double usando big endian */
+static inline double utl_io_getd_fb(uint8_t* src_ptr)
+{
+    uint64_t value = utl_io_get64_fb(src_ptr);
+    double ret;
+    memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+/** Pega um uint8_t usando little endian e adiciona o ponteiro */
+static inline uint8_t utl_io_get8_fl_apr(uint8_t** buf)
+{
+    uint8_t value = utl_io_get8_fl(*buf);
+    *buf += 1;
+    return value;
+}
+
+/** Pega um uint8_t usando big endian e adiciona o ponteiro */
+static inline uint8_t utl_io_get8_fb_apr(uint8_t** buf)
+{
+    uint8_t value = utl_io_get8_fb(*buf);
+    *buf += 1;
+    return value;
+}
 #define utl_io_get8_fl_ap(x) utl_io_get8_fl_apr(&x) /**< Macro para facilitar @ref utl_io_get8_fl_apr */
 #define utl_io_get8_fb_ap(x) utl_io_get8_fb_apr(&x) /**< Macro para facilitar @ref utl_io_get8_fb_apr */
 
-uint16_t utl_io_get16_fl(uint8_t* buf);      /**< Pega um uint16_t usando little endian */
-uint16_t utl_io_get16_fb(uint8_t* buf);      /**< Pega um uint16_t usando big endian */
-uint16_t utl_io_get16_fl_apr(uint8_t** buf); /**< Pega um uint16_t usando little endian e adiciona o ponteiro */
-uint16_t utl_io_get16_fb_apr(uint8_t** buf); /**< Pega um uint16_t usando big endian e adiciona o ponteiro */
+/** Pega um uint16_t usando little endian e adiciona o ponteiro */
+static inline uint16_t utl_io_get16_fl_apr(uint8_t** buf)
+{
+    uint16_t value = utl_io_get16_fl(*buf);
+    *buf += 2;
+    return value;
+}
+
+/** Pega um uint16_t usando big endian e adiciona o ponteiro */
+static inline uint16_t utl_io_get16_fb_apr(uint8_t** buf)
+{
+    uint16_t value = utl_io_get16_fb(*buf);
+    *buf += 2;
+    return value;
+}
 #define utl_io_get16_fl_ap(x) utl_io_get16_fl_apr(&x) /**< Macro para facilitar @ref utl_io_get16_fl_apr */
 #define utl_io_get16_fb_ap(x) utl_io_get16_fb_apr(&x) /**< Macro para facilitar @ref utl_io_get16_fb_apr */
 
-uint32_t utl_io_get32_fl(uint8_t* buf);      /**< Pega um uint32_t usando little endian */
-uint32_t utl_io_get32_fb(uint8_t* buf);      /**< Pega um uint32_t usando big endian */
-uint32_t utl_io_get32_fl_apr(uint8_t** buf); /**< Pega um uint32_t usando little endian e adiciona o ponteiro */
-uint32_t utl_io_get32_fb_apr(uint8_t** buf); /**< Pega um uint32_t usando big endian e adiciona o ponteiro */
+/** Pega um uint32_t usando little endian e adiciona o ponteiro */
+static inline uint32_t utl_io_get32_fl_apr(uint8_t** buf)
+{
+    uint32_t value = utl_io_get32_fl(*buf);
+    *buf += 4;
+    return value;
+}
+
+/** Pega um uint32_t usando big endian e adiciona o ponteiro */
+static inline uint32_t utl_io_get32_fb_apr(uint8_t** buf)
+{
+    uint32_t value = utl_io_get32_fb(*buf);
+    *buf += 4;
+    return value;
+}
 #define utl_io_get32_fl_ap(x) utl_io_get32_fl_apr(&x) /**< Macro para facilitar @ref utl_io_get32_fl_apr */
 #define utl_io_get32_fb_ap(x) utl_io_get32_fb_apr(&x) /**< Macro para facilitar @ref utl_io_get32_fb_apr */
 
-uint64_t utl_io_get64_fl(uint8_t* buf);      /**< Pega um uint64_t usando little endian */
-uint64_t utl_io_get64_fb(uint8_t* buf);      /**< Pega um uint64_t usando big endian */
-uint64_t utl_io_get64_fl_apr(uint8_t** buf); /**< Pega um uint64_t usando little endian e adiciona o ponteiro */
-uint64_t utl_io_get64_fb_apr(uint8_t** buf); /**< Pega um uint64_t usando big endian e adiciona o ponteiro */
+/** Pega um uint64_t usando little endian e adiciona o ponteiro */
+static inline uint64_t utl_io_get64_fl_apr(uint8_t** buf)
+{
+    uint64_t value = utl_io_get64_fl(*buf);
+    *buf += 8;
+    return value;
+}
+
+/** Pega um uint64_t usando big endian e adiciona o ponteiro */
+static inline uint64_t utl_io_get64_fb_apr(uint8_t** buf)
+{
+    uint64_t value = utl_io_get64_fb(*buf);
+    *buf += 8;
+    return value;
+}
 #define utl_io_get64_fl_ap(x) utl_io_get64_fl_apr(&x) /**< Macro para facilitar @ref utl_io_get64_fl_apr */
 #define utl_io_get64_fb_ap(x) utl_io_get64_fb_apr(&x) /**< Macro para facilitar @ref utl_io_get64_fb_apr */
 
-float utl_io_getf_fl(uint8_t* src_ptr);             /**< Pega um float usando little endian */
-float utl_io_getf_fb(uint8_t* src_ptr);             /**< Pega um float usando big endian */
-float utl_io_getf_fl_apr(uint8_t** src_ptr);        /**< Pega um float usando little endian e adiciona o ponteiro */
-float utl_io_getf_fb_apr(uint8_t** src_ptr);        /**< Pega um float usando big endian e adiciona o ponteiro */
+/** Pega um float usando little endian e adiciona o ponteiro */
+static inline float utl_io_getf_fl_apr(uint8_t** buf)
+{
+    float value = utl_io_getf_fl(*buf);
+    *buf += 4;
+    return value;
+}
+
+/** Pega um float usando big endian e adiciona o ponteiro */
+static inline float utl_io_getf_fb_apr(uint8_t** buf)
+{
+    float value = utl_io_getf_fb(*buf);
+    *buf += 4;
+    return value;
+}
 #define utl_io_getf_fl_ap(x) utl_io_getf_fl_apr(&x) /**< Macro para facilitar @ref utl_io_getf_fl_apr */
 #define utl_io_getf_fb_ap(x) utl_io_getf_fb_apr(&x) /**< Macro para facilitar @ref utl_io_getf_fb_apr */
 
-double utl_io_getd_fl(uint8_t* src_ptr);            /**< Pega um double usando little endian */
-double utl_io_getd_fb(uint8_t* src_ptr);            /**< Pega um double usando big endian */
-double utl_io_getd_fl_apr(uint8_t** src_ptr);       /**< Pega um double usando little endian e adiciona o ponteiro */
-double utl_io_getd_fb_apr(uint8_t** src_ptr);       /**< Pega um double usando big endian e adiciona o ponteiro */
+/** Pega um double usando little endian e adiciona o ponteiro */
+static inline double utl_io_getd_fl_apr(uint8_t** buf)
+{
+    double value = utl_io_getd_fl(*buf);
+    *buf += 8;
+    return value;
+}
+
+/** Pega um double usando big endian e adiciona o ponteiro */
+static inline double utl_io_getd_fb_apr(uint8_t** buf)
+{
+    double value = utl_io_getd_fb(*buf);
+    *buf += 8;
+    return value;
+}
 #define utl_io_getd_fl_ap(x) utl_io_getd_fl_apr(&x) /**< Macro para facilitar @ref utl_io_getd_fl_apr */
 #define utl_io_getd_fb_ap(x) utl_io_getd_fb_apr(&x) /**< Macro para facilitar @ref utl_io_getd_fb_apr */
 /** @} */
@@ -125,57 +394,258 @@ double utl_io_getd_fb_apr(uint8_t** src_ptr);       /**< Pega um double usando b
   @name Funções dependentes de alinhamento (PUT)
   @{
 */
-void utl_io_put8_tl(uint8_t value, uint8_t* buf); /**< Coloca um uint8_t usando little endian */
-void utl_io_put8_tb(uint8_t value, uint8_t* buf); /**< Coloca um uint8_t usando big endian */
-void utl_io_put8_tl_apr(uint8_t value,
-                        uint8_t** buf); /**< Coloca um uint8_t usando little endian e adiciona o ponteiro */
-void utl_io_put8_tb_apr(uint8_t value, uint8_t** buf); /**< Coloca um uint8_t usando big endian e adiciona o ponteiro */
+
+/** Coloca um uint8_t usando little endian */
+static inline void utl_io_put8_tl(uint8_t value, uint8_t* buf)
+{
+    buf[0] = value;
+}
+
+/** Coloca um uint8_t usando big endian */
+static inline void utl_io_put8_tb(uint8_t value, uint8_t* buf)
+{
+    buf[0] = value;
+}
+
+#if UTL_IO_BUILTIN_ENABLED
+/** Coloca um uint16_t usando little endian */
+static inline void utl_io_put16_tl(uint16_t value, uint8_t* buf)
+{
+    value = UTL_IO_LE16(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+/** Coloca um uint16_t usando big endian */
+static inline void utl_io_put16_tb(uint16_t value, uint8_t* buf)
+{
+    value = UTL_IO_BE16(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+/** Coloca um uint32_t usando little endian */
+static inline void utl_io_put32_tl(uint32_t value, uint8_t* buf)
+{
+    value = UTL_IO_LE32(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+/** Coloca um uint32_t usando big endian */
+static inline void utl_io_put32_tb(uint32_t value, uint8_t* buf)
+{
+    value = UTL_IO_BE32(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+/** Coloca um uint64_t usando little endian */
+static inline void utl_io_put64_tl(uint64_t value, uint8_t* buf)
+{
+    value = UTL_IO_LE64(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+/** Coloca um uint64_t usando big endian */
+static inline void utl_io_put64_tb(uint64_t value, uint8_t* buf)
+{
+    value = UTL_IO_BE64(value);
+    memcpy(buf, &value, sizeof(value));
+}
+
+#else
+/** Coloca um uint16_t usando little endian */
+static inline void utl_io_put16_tl(uint16_t value, uint8_t* buf)
+{
+    buf[0] = (uint8_t) (value);
+    buf[1] = (uint8_t) (value >> 8);
+}
+
+/** Coloca um uint16_t usando big endian */
+static inline void utl_io_put16_tb(uint16_t value, uint8_t* buf)
+{
+    buf[1] = (uint8_t) (value);
+    buf[0] = (uint8_t) (value >> 8);
+}
+
+/** Coloca um uint32_t usando little endian */
+static inline void utl_io_put32_tl(uint32_t value, uint8_t* buf)
+{
+    buf[0] = (uint8_t) (value);
+    buf[1] = (uint8_t) (value >> 8);
+    buf[2] = (uint8_t) (value >> 16);
+    buf[3] = (uint8_t) (value >> 24);
+}
+
+/** Coloca um uint32_t usando big endian */
+static inline void utl_io_put32_tb(uint32_t value, uint8_t* buf)
+{
+    buf[3] = (uint8_t) (value);
+    buf[2] = (uint8_t) (value >> 8);
+    buf[1] = (uint8_t) (value >> 16);
+    buf[0] = (uint8_t) (value >> 24);
+}
+
+/** Coloca um uint64_t usando little endian */
+static inline void utl_io_put64_tl(uint64_t value, uint8_t* buf)
+{
+    buf[0] = (uint8_t) (value);
+    buf[1] = (uint8_t) (value >> 8);
+    buf[2] = (uint8_t) (value >> 16);
+    buf[3] = (uint8_t) (value >> 24);
+    buf[4] = (uint8_t) (value >> 32);
+    buf[5] = (uint8_t) (value >> 40);
+    buf[6] = (uint8_t) (value >> 48);
+    buf[7] = (uint8_t) (value >> 56);
+}
+
+/** Coloca um uint64_t usando big endian */
+static inline void utl_io_put64_tb(uint64_t value, uint8_t* buf)
+{
+    buf[7] = (uint8_t) (value);
+    buf[6] = (uint8_t) (value >> 8);
+    buf[5] = (uint8_t) (value >> 16);
+    buf[4] = (uint8_t) (value >> 24);
+    buf[3] = (uint8_t) (value >> 32);
+    buf[2] = (uint8_t) (value >> 40);
+    buf[1] = (uint8_t) (value >> 48);
+    buf[0] = (uint8_t) (value >> 56);
+}
+
+#endif
+
+/** Coloca um float usando little endian */
+static inline void utl_io_putf_tl(float value, uint8_t* buf)
+{
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    utl_io_put32_tl(raw, buf);
+}
+
+/** Coloca um float usando big endian */
+static inline void utl_io_putf_tb(float value, uint8_t* buf)
+{
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    utl_io_put32_tb(raw, buf);
+}
+
+/** Coloca um double usando little endian */
+static inline void utl_io_putd_tl(double value, uint8_t* buf)
+{
+    uint64_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    utl_io_put64_tl(raw, buf);
+}
+
+/** Coloca um double usando big endian */
+static inline void utl_io_putd_tb(double value, uint8_t* buf)
+{
+    uint64_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    utl_io_put64_tb(raw, buf);
+}
+
+/** Coloca um uint8_t usando little endian e adiciona o ponteiro */
+static inline void utl_io_put8_tl_apr(uint8_t value, uint8_t** buf)
+{
+    utl_io_put8_tl(value, *buf);
+    *buf += 1;
+}
+
+/** Coloca um uint8_t usando big endian e adiciona o ponteiro */
+static inline void utl_io_put8_tb_apr(uint8_t value, uint8_t** buf)
+{
+    utl_io_put8_tb(value, *buf);
+    *buf += 1;
+}
 #define utl_io_put8_tl_ap(v, x) utl_io_put8_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_put8_tl_apr */
 #define utl_io_put8_tb_ap(v, x) utl_io_put8_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_put8_tb_apr */
 
-void utl_io_put16_tl(uint16_t value, uint8_t* buf); /**< Coloca um uint16_t usando little endian */
-void utl_io_put16_tb(uint16_t value, uint8_t* buf); /**< Coloca um uint16_t usando big endian */
-void utl_io_put16_tl_apr(uint16_t value,
-                         uint8_t** buf); /**< Coloca um uint16_t usando little endian e adiciona o ponteiro */
-void utl_io_put16_tb_apr(uint16_t value,
-                         uint8_t** buf); /**< Coloca um uint16_t usando big endian e adiciona o ponteiro */
+/** Coloca um uint16_t usando little endian e adiciona o ponteiro */
+static inline void utl_io_put16_tl_apr(uint16_t value, uint8_t** buf)
+{
+    utl_io_put16_tl(value, *buf);
+    *buf += 2;
+}
+
+/** Coloca um uint16_t usando big endian e adiciona o ponteiro */
+static inline void utl_io_put16_tb_apr(uint16_t value, uint8_t** buf)
+{
+    utl_io_put16_tb(value, *buf);
+    *buf += 2;
+}
 #define utl_io_put16_tl_ap(v, x) utl_io_put16_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_put16_tl_apr */
 #define utl_io_put16_tb_ap(v, x) utl_io_put16_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_put16_tb_apr */
 
-void utl_io_put32_tl(uint32_t value, uint8_t* buf); /**< Coloca um uint32_t usando little endian */
-void utl_io_put32_tb(uint32_t value, uint8_t* buf); /**< Coloca um uint32_t usando big endian */
-void utl_io_put32_tl_apr(uint32_t value,
-                         uint8_t** buf); /**< Coloca um uint32_t usando little endian e adiciona o ponteiro */
-void utl_io_put32_tb_apr(uint32_t value,
-                         uint8_t** buf); /**< Coloca um uint32_t usando big endian e adiciona o ponteiro */
+/** Coloca um uint32_t usando little endian e adiciona o ponteiro */
+static inline void utl_io_put32_tl_apr(uint32_t value, uint8_t** buf)
+{
+    utl_io_put32_tl(value, *buf);
+    *buf += 4;
+}
+
+/** Coloca um uint32_t usando big endian e adiciona o ponteiro */
+static inline void utl_io_put32_tb_apr(uint32_t value, uint8_t** buf)
+{
+    utl_io_put32_tb(value, *buf);
+    *buf += 4;
+}
 #define utl_io_put32_tl_ap(v, x) utl_io_put32_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_put32_tl_apr */
 #define utl_io_put32_tb_ap(v, x) utl_io_put32_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_put32_tb_apr */
 
-void utl_io_put64_tl(uint64_t value, uint8_t* buf); /**< Coloca um uint64_t usando little endian */
-void utl_io_put64_tb(uint64_t value, uint8_t* buf); /**< Coloca um uint64_t usando big endian */
-void utl_io_put64_tl_apr(uint64_t value,
-                         uint8_t** buf); /**< Coloca um uint64_t usando little endian e adiciona o ponteiro */
-void utl_io_put64_tb_apr(uint64_t value,
-                         uint8_t** buf); /**< Coloca um uint64_t usando big endian e adiciona o ponteiro */
+/** Coloca um uint64_t usando little endian e adiciona o ponteiro */
+static inline void utl_io_put64_tl_apr(uint64_t value, uint8_t** buf)
+{
+    utl_io_put64_tl(value, *buf);
+    *buf += 8;
+}
+
+/** Coloca um uint64_t usando big endian e adiciona o ponteiro */
+static inline void utl_io_put64_tb_apr(uint64_t value, uint8_t** buf)
+{
+    utl_io_put64_tb(value, *buf);
+    *buf += 8;
+}
 #define utl_io_put64_tl_ap(v, x) utl_io_put64_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_put64_tl_apr */
 #define utl_io_put64_tb_ap(v, x) utl_io_put64_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_put64_tb_apr */
 
-void utl_io_putf_tl(float value, uint8_t* buf);      /**< Coloca um float usando little endian */
-void utl_io_putf_tb(float value, uint8_t* buf);      /**< Coloca um float usando big endian */
-void utl_io_putf_tl_apr(float value, uint8_t** buf); /**< Coloca um float usando little endian e adiciona o ponteiro */
-void utl_io_putf_tb_apr(float value, uint8_t** buf); /**< Coloca um float usando big endian e adiciona o ponteiro */
+/** Coloca um float usando little endian e adiciona o ponteiro */
+static inline void utl_io_putf_tl_apr(float value, uint8_t** buf)
+{
+    utl_io_putf_tl(value, *buf);
+    *buf += 4;
+}
+
+/** Coloca um float usando big endian e adiciona o ponteiro */
+static inline void utl_io_putf_tb_apr(float value, uint8_t** buf)
+{
+    utl_io_putf_tb(value, *buf);
+    *buf += 4;
+}
 #define utl_io_putf_tl_ap(v, x) utl_io_putf_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_putf_tl_apr */
 #define utl_io_putf_tb_ap(v, x) utl_io_putf_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_putf_tb_apr */
 
-void utl_io_putd_tl(double value, uint8_t* buf); /**< Coloca um double usando little endian */
-void utl_io_putd_tb(double value, uint8_t* buf); /**< Coloca um double usando big endian */
-void utl_io_putd_tl_apr(double value,
-                        uint8_t** buf); /**< Coloca um double usando little endian e adiciona o ponteiro */
-void utl_io_putd_tb_apr(double value, uint8_t** buf); /**< Coloca um double usando big endian e adiciona o ponteiro */
+/** Coloca um double usando little endian e adiciona o ponteiro */
+static inline void utl_io_putd_tl_apr(double value, uint8_t** buf)
+{
+    utl_io_putd_tl(value, *buf);
+    *buf += 8;
+}
+
+/** Coloca um double usando big endian e adiciona o ponteiro */
+static inline void utl_io_putd_tb_apr(double value, uint8_t** buf)
+{
+    utl_io_putd_tb(value, *buf);
+    *buf += 8;
+}
 #define utl_io_putd_tl_ap(v, x) utl_io_putd_tl_apr(v, &x) /**< Macro para facilitar @ref utl_io_putd_tl_apr */
 #define utl_io_putd_tb_ap(v, x) utl_io_putd_tb_apr(v, &x) /**< Macro para facilitar @ref utl_io_putd_tb_apr */
 
-void utl_io_memcpy_tl(uint8_t* dst, const uint8_t* src, uint16_t size); /**< Copia um buffer usando little endian */
+/** Copia um buffer usando little endian */
+static inline void utl_io_memcpy_tl(uint8_t* dst, const uint8_t* src, uint16_t size)
+{
+    dst = dst + (size - 1);
+    while(size--)
+        *dst-- = *src++;
+}
 
 /** @} */
 
@@ -0,0 +1,128 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "utl_mpsc.h"
+
+// o seq de cada slot é guardado relativo ao seu índice (zerado == slot livre para a primeira volta)
+#define MPSC_SEQ_LOAD(q, i) (atomic_load_explicit(&(q)->slots[i].seq, memory_order_acquire) + (i))
+#define MPSC_SEQ_STORE(q, i, v) atomic_store_explicit(&(q)->slots[i].seq, (v) - (i), memory_order_release)
+
+// bit de utl_mpsc_t::waiting: consumidor aguardando registro (dorme no seq do slot em tail)
+#define MPSC_WAITING_DATA 0x01
+
+utl_cbf_status_t utl_mpsc_init(utl_mpsc_t* q, utl_mpsc_slot_t* slots, uint32_t size)
+{
+    if(!UTL_CBF_SIZE_IS_VALID(size))
+        return UTL_CBF_ERROR;
+
+    q->slots = slots;
+    q->size = size;
+    q->mask = size - 1;
+    q->tail = 0;
+    q->wait = false;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->waiting, 0);
+
+    for(uint32_t n = 0; n < size; n++)
+        atomic_init(&slots[n].seq, 0);
+
+    return UTL_CBF_OK;
+}
+
+utl_cbf_status_t utl_mpsc_put(utl_mpsc_t* q, uint8_t tag, const uint8_t* data, size_t len)
+{
+    uint32_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    uint32_t idx;
+
+    if(len > UTL_MPSC_RECORD_SIZE)
+        return UTL_CBF_ERROR;
+
+    while(true)
+    {
+        idx = pos & q->mask;
+        int32_t diff = (int32_t) (MPSC_SEQ_LOAD(q, idx) - pos);
+
+        if(diff == 0)
+        {
+            // slot livre nesta volta: tenta reservar a posição
+            if(atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1, memory_order_relaxed,
+                                                     memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0)
+        {
+            // o consumidor ainda não liberou o slot da volta anterior
+            return UTL_CBF_FULL;
+        }
+        else
+        {
+            // outro produtor já ocupou esta posição
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+
+    utl_mpsc_slot_t* slot = &q->slots[idx];
+    slot->tag = tag;
+    slot->len = (uint16_t) len;
+    memcpy(slot->data, data, len);
+    MPSC_SEQ_STORE(q, idx, pos + 1);
+#if UTL_CBF_WAIT_ENABLED
+    if(q->wait)
+        utl_cbf_wake_idx(&q->waiting, MPSC_WAITING_DATA, &slot->seq);
+#endif
+
+    return UTL_CBF_OK;
+}
+
+utl_cbf_status_t utl_mpsc_get(utl_mpsc_t* q, uint8_t* tag, uint8_t* data, size_t* len)
+{
+    uint32_t idx = q->tail & q->mask;
+
+    if((int32_t) (MPSC_SEQ_LOAD(q, idx) - (q->tail + 1)) < 0)
+        return UTL_CBF_EMPTY;
+
+    utl_mpsc_slot_t* slot = &q->slots[idx];
+    *tag = slot->tag;
+    *len = slot->len;
+    memcpy(data, slot->data, slot->len);
+
+    // libera o slot para a próxima volta
+    MPSC_SEQ_STORE(q, idx, q->tail + q->size);
+    q->tail++;
+
+    return UTL_CBF_OK;
+}
+
+uint32_t utl_mpsc_records_available(utl_mpsc_t* q)
+{
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    return head - q->tail;
+}
+
+#if UTL_CBF_WAIT_ENABLED
+void utl_mpsc_wait_set(utl_mpsc_t* q, bool enable)
+{
+    q->wait = enable;
+}
+
+utl_cbf_status_t utl_mpsc_get_wait(utl_mpsc_t* q, uint8_t* tag, uint8_t* data, size_t* len, uint32_t timeout_ms)
+{
+    uint64_t start = timeout_ms == UTL_CBF_WAIT_FOREVER ? 0 : utl_cbf_time_ms();
+
+    if(!q->wait)
+        return UTL_CBF_ERROR;
+
+    while(utl_mpsc_get(q, tag, data, len) != UTL_CBF_OK)
+    {
+        // não publicado: o seq do slot ainda vale tail (guardado relativo ao índice)
+        uint32_t idx = q->tail & q->mask;
+        if(!utl_cbf_wait_idx(&q->waiting, MPSC_WAITING_DATA, &q->slots[idx].seq, q->tail - idx, start, timeout_ms))
+            return UTL_CBF_TMROUT;
+    }
+
+    return UTL_CBF_OK;
+}
+#endif
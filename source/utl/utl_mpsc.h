@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+
+#include "utl_cbf.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Tamanho máximo, em bytes, de um registro da fila MPSC */
+#ifndef UTL_MPSC_RECORD_SIZE
+#define UTL_MPSC_RECORD_SIZE 64
+#endif
+
+/**
+ @brief Slot de um registro da fila MPSC.
+ O campo @c seq é armazenado relativo ao índice do slot, de forma que uma área zerada (ex: variável estática)
+ já representa uma fila vazia e válida.
+*/
+typedef struct utl_mpsc_slot_s
+{
+    _Atomic(uint32_t) seq;
+    uint16_t len;
+    uint8_t tag;
+    uint8_t data[UTL_MPSC_RECORD_SIZE];
+} utl_mpsc_slot_t;
+
+/**
+ @brief Fila de registros com vários produtores e um consumidor (MPSC), sem travas.
+
+ Cada registro carrega até @ref UTL_MPSC_RECORD_SIZE bytes e uma etiqueta (@c tag) que identifica a origem
+ (ex: a porta UART). Os produtores disputam a posição de escrita com uma única operação CAS e publicam o
+ registro pelo @c seq do slot, portanto um produtor lento não bloqueia os demais. O consumidor espera numa
+ única fila em vez de consultar N buffers circulares.
+*/
+typedef struct utl_mpsc_s
+{
+    // disputado pelos produtores
+    alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) head;
+    // lado do consumidor
+    alignas(UTL_CBF_CACHE_LINE_SIZE) uint32_t tail;
+    // somente leitura após a inicialização
+    alignas(UTL_CBF_CACHE_LINE_SIZE) uint32_t size;
+    uint32_t mask;
+    utl_mpsc_slot_t* slots;
+    bool wait;
+    // escrito pelo consumidor ao dormir, lido pelos produtores a cada publicação com espera habilitada
+    alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) waiting;
+} utl_mpsc_t;
+
+#define UTL_MPSC_DECLARE(name, _size)                                                                 \
+    _Static_assert(UTL_CBF_SIZE_IS_VALID(_size), "utl_mpsc: size must be a power of 2 (" #name ")"); \
+    static utl_mpsc_slot_t name##slots[_size];                                                       \
+    static utl_mpsc_t name = {                                                                       \
+        .head = 0,                                                                                   \
+        .tail = 0,                                                                                   \
+        .size = _size,                                                                               \
+        .mask = (_size) - 1,                                                                         \
+        .slots = name##slots,                                                                        \
+        .wait = false,                                                                               \
+        .waiting = 0,                                                                                \
+    }
+
+/**
+ @brief Inicializa uma fila MPSC, caso não tenha sido declarada com @ref UTL_MPSC_DECLARE.
+ Não deve ser chamada com produtores ou consumidor em execução.
+ @param[in] q - ponteiro para a fila.
+ @param[in] slots - área previamente alocada com @p size slots.
+ @param[in] size - quantidade de slots (potência de 2).
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se @p size for inválido)
+*/
+utl_cbf_status_t utl_mpsc_init(utl_mpsc_t* q, utl_mpsc_slot_t* slots, uint32_t size);
+/**
+ @brief Coloca um registro na fila. Pode ser chamada por qualquer número de produtores simultaneamente.
+ @param[in] q - ponteiro para a fila.
+ @param[in] tag - identificação da origem do registro.
+ @param[in] data - conteúdo do registro.
+ @param[in] len - tamanho de @p data (até @ref UTL_MPSC_RECORD_SIZE).
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se @p len for muito grande)
+*/
+utl_cbf_status_t utl_mpsc_put(utl_mpsc_t* q, uint8_t tag, const uint8_t* data, size_t len);
+/**
+ @brief Retira o próximo registro da fila. Apenas um consumidor pode chamar esta função por fila.
+ @param[in] q - ponteiro para a fila.
+ @param[out] tag - identificação da origem do registro.
+ @param[out] data - destino do conteúdo (com pelo menos @ref UTL_MPSC_RECORD_SIZE bytes).
+ @param[out] len - tamanho do registro retirado.
+ @return ver @ref cbf_status_s
+*/
+utl_cbf_status_t utl_mpsc_get(utl_mpsc_t* q, uint8_t* tag, uint8_t* data, size_t* len);
+/**
+ @brief Retorna a quantidade de registros reservados na fila, incluindo os que ainda estão sendo escritos.
+ Deve ser chamada pelo consumidor.
+ @param[in] q - ponteiro para a fila.
+ @return quantidade de registros
+*/
+uint32_t utl_mpsc_records_available(utl_mpsc_t* q);
+
+#if UTL_CBF_WAIT_ENABLED
+/**
+ @brief Habilita @ref utl_mpsc_get_wait na fila. Sem esta chamada os produtores não verificam se o consumidor
+ está dormindo e @ref utl_mpsc_get_wait retorna @c UTL_CBF_ERROR. Não deve ser chamada com produtores ou
+ consumidor em execução.
+ @param[in] q - ponteiro para a fila.
+ @param[in] enable - true para permitir que o consumidor durma esperando pelos produtores.
+*/
+void utl_mpsc_wait_set(utl_mpsc_t* q, bool enable);
+/**
+ @brief Retira o próximo registro da fila, dormindo até que um produtor o publique ou o tempo se esgote.
+ O consumidor dorme no @c seq do slot seguinte e o produtor que o publica o acorda (mesma espera de
+ @ref utl_cbf_get_wait). Apenas um consumidor pode chamar esta função por fila.
+ @param[in] q - ponteiro para a fila.
+ @param[out] tag - identificação da origem do registro.
+ @param[out] data - destino do conteúdo (com pelo menos @ref UTL_MPSC_RECORD_SIZE bytes).
+ @param[out] len - tamanho do registro retirado.
+ @param[in] timeout_ms - tempo máximo de espera em ms (ou @ref UTL_CBF_WAIT_FOREVER).
+ @return ver @ref cbf_status_s (@c UTL_CBF_TMROUT se nenhum registro chegou a tempo, @c UTL_CBF_ERROR sem
+ @ref utl_mpsc_wait_set)
+*/
+utl_cbf_status_t utl_mpsc_get_wait(utl_mpsc_t* q, uint8_t* tag, uint8_t* data, size_t* len, uint32_t timeout_ms);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "utl_rec.h"
+
+// cabeçalho que marca o restante da área de dados, até o fim, como preenchimento
+#define REC_PAD 0xFFFF
+
+utl_cbf_status_t utl_rec_push(utl_cbf_t* cb, const uint8_t* data, size_t len)
+{
+    uint32_t span = UTL_REC_SPAN(len);
+    uint16_t hdr = (uint16_t) len;
+    uint8_t* ptr;
+    size_t avail;
+
+    if(cb->overwrite || len > UTL_REC_MAX_LEN || span > cb->size)
+        return UTL_CBF_ERROR;
+
+    ptr = utl_cbf_write_reserve(cb, &avail);
+    if(ptr && avail < span && !cb->mirrored && avail == cb->size - (uint32_t) (ptr - cb->buffer))
+    {
+        // o fim da área de dados está livre mas não comporta o registro: recomeça no início
+        uint16_t pad = REC_PAD;
+        memcpy(ptr, &pad, sizeof(pad));
+        utl_cbf_write_commit(cb, avail);
+        ptr = utl_cbf_write_reserve(cb, &avail);
+    }
+
+    if(!ptr || avail < span)
+        return UTL_CBF_FULL;
+
+    memcpy(ptr, &hdr, sizeof(hdr));
+    memcpy(ptr + UTL_REC_HEADER_SIZE, data, len);
+
+    return utl_cbf_write_commit(cb, span);
+}
+
+const uint8_t* utl_rec_peek(utl_cbf_t* cb, size_t* len)
+{
+    const uint8_t* ptr;
+    uint16_t hdr;
+    size_t avail;
+
+    while((ptr = utl_cbf_read_peek(cb, &avail)) != NULL)
+    {
+        memcpy(&hdr, ptr, sizeof(hdr));
+        if(hdr != REC_PAD)
+        {
+            *len = hdr;
+            return ptr + UTL_REC_HEADER_SIZE;
+        }
+        // o preenchimento sempre vai até o fim da área de dados
+        utl_cbf_read_release(cb, cb->size - (uint32_t) (ptr - cb->buffer));
+    }
+
+    *len = 0;
+
+    return NULL;
+}
+
+utl_cbf_status_t utl_rec_release(utl_cbf_t* cb)
+{
+    size_t len;
+
+    if(!utl_rec_peek(cb, &len))
+        return UTL_CBF_EMPTY;
+
+    return utl_cbf_read_release(cb, UTL_REC_SPAN(len));
+}
+
+utl_cbf_status_t utl_rec_pop(utl_cbf_t* cb, uint8_t* dst, size_t size, size_t* len)
+{
+    const uint8_t* ptr = utl_rec_peek(cb, len);
+
+    if(!ptr)
+        return UTL_CBF_EMPTY;
+
+    if(*len > size)
+        return UTL_CBF_ERROR;
+
+    memcpy(dst, ptr, *len);
+
+    return utl_cbf_read_release(cb, UTL_REC_SPAN(*len));
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utl_cbf.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Tamanho do cabeçalho de comprimento que precede cada registro */
+#define UTL_REC_HEADER_SIZE 2
+
+/** @brief Maior registro aceito (o valor 0xFFFF do cabeçalho é reservado para o preenchimento) */
+#define UTL_REC_MAX_LEN 0xFFFE
+
+/** @brief Espaço ocupado no buffer circular por um registro de @p len bytes (cabeçalho incluso, alinhado a 2) */
+#define UTL_REC_SPAN(len) ((uint32_t) (UTL_REC_HEADER_SIZE + (len) + 1) & ~UINT32_C(1))
+
+/*
+ Registros de tamanho variável (ex: sentenças NMEA ou quadros COBS completos) sobre um @ref utl_cbf_t.
+
+ Cada registro é gravado de forma contígua, precedido por um cabeçalho de 16 bits com seu comprimento, e
+ publicado de uma só vez com @ref utl_cbf_write_commit. Quando um registro não cabe antes do fim da área de
+ dados, o restante é marcado como preenchimento e o registro recomeça no início, de forma que o consumidor
+ sempre recebe o registro inteiro num único ponteiro, sem cópias. Registros ocupam um número par de bytes,
+ garantindo que o cabeçalho nunca seja dividido no ponto de retorno. Em buffers espelhados
+ (@ref utl_cbf_mirror_init) o preenchimento nunca é necessário.
+
+ As mesmas regras do @ref utl_cbf_t valem aqui: um produtor e um consumidor por buffer. O buffer não pode
+ ser misturado com as funções de bytes nem estar no modo de sobrescrita, que quebrariam o enquadramento.
+*/
+
+/**
+ @brief Coloca um registro no buffer circular.
+ Apenas um produtor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[in] data - conteúdo do registro.
+ @param[in] len - tamanho de @p data (até @ref UTL_REC_MAX_LEN e com @ref UTL_REC_SPAN(len) até o tamanho do buffer).
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se @p len for grande demais ou o buffer estiver no modo de
+ sobrescrita)
+*/
+utl_cbf_status_t utl_rec_push(utl_cbf_t* cb, const uint8_t* data, size_t len);
+/**
+ @brief Retira o próximo registro do buffer circular.
+ Apenas um consumidor pode chamar esta função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] dst - destino do conteúdo do registro.
+ @param[in] size - tamanho de @p dst.
+ @param[out] len - tamanho do registro retirado.
+ @return ver @ref cbf_status_s (@c UTL_CBF_ERROR se o registro não couber em @p dst; ele permanece no buffer)
+*/
+utl_cbf_status_t utl_rec_pop(utl_cbf_t* cb, uint8_t* dst, size_t size, size_t* len);
+/**
+ @brief Obtém acesso direto ao próximo registro, sem retirá-lo (zero-copy).
+ O registro permanece válido até a chamada de @ref utl_rec_release. Apenas um consumidor pode chamar esta
+ função por buffer.
+ @param[in] cb - ponteiro para o buffer circular.
+ @param[out] len - tamanho do registro.
+ @return ponteiro para o conteúdo do registro ou NULL se não houver registros
+*/
+const uint8_t* utl_rec_peek(utl_cbf_t* cb, size_t* len);
+/**
+ @brief Libera o registro obtido com @ref utl_rec_peek.
+ @param[in] cb - ponteiro para o buffer circular.
+ @return ver @ref cbf_status_s (@c UTL_CBF_EMPTY se não houver registros)
+*/
+utl_cbf_status_t utl_rec_release(utl_cbf_t* cb);
+
+#ifdef __cplusplus
+}
+#endif
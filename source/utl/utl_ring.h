@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+
+#include "utl_cbf.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ Buffers circulares tipados, gerados por macro, para trocar estruturas inteiras entre threads
+ (ex: @c struct gps_tpv) sem serializá-las byte a byte num @ref utl_cbf_t.
+
+ Seguem as mesmas regras do @ref utl_cbf_t: um produtor e um consumidor, índices livres de 32 bits em linhas
+ de cache separadas, cada um com uma cópia local do índice do outro lado, e publicação release/acquire.
+ Os elementos são copiados por atribuição, portanto o compilador gera a cópia ideal para o tipo.
+
+ Exemplo:
+
+    UTL_RING_DECLARE_TYPED(fixes, struct gps_tpv, 8);
+
+    fixes_push(&fixes, &tpv);          // produtor
+    if(fixes_pop(&fixes, &tpv) == UTL_CBF_OK) // consumidor
+        ...
+*/
+
+/**
+ @brief Define o tipo @c name_t de um buffer circular de @p _size elementos de @p type e suas funções:
+ @c name_init, @c name_push, @c name_pop e @c name_count. Uma instância zerada (ex: variável estática) já é
+ um buffer vazio e válido.
+*/
+#define UTL_RING_DEFINE_TYPED(name, type, _size)                                                        \
+    typedef struct name##_s                                                                             \
+    {                                                                                                   \
+        alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) prod;                                        \
+        uint32_t cons_cache;                                                                            \
+        alignas(UTL_CBF_CACHE_LINE_SIZE) _Atomic(uint32_t) cons;                                        \
+        uint32_t prod_cache;                                                                            \
+        alignas(UTL_CBF_CACHE_LINE_SIZE) type items[_size];                                             \
+    } name##_t;                                                                                         \
+                                                                                                        \
+    static inline void name##_init(name##_t* r)                                                         \
+    {                                                                                                   \
+        r->cons_cache = r->prod_cache = 0;                                                              \
+        atomic_init(&r->prod, 0);                                                                       \
+        atomic_init(&r->cons, 0);                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    static inline utl_cbf_status_t name##_push(name##_t* r, const type* item)                           \
+    {                                                                                                   \
+        uint32_t prod = atomic_load_explicit(&r->prod, memory_order_relaxed);                           \
+                                                                                                        \
+        if(prod - r->cons_cache == (_size))                                                             \
+        {                                                                                               \
+            r->cons_cache = atomic_load_explicit(&r->cons, memory_order_acquire);                       \
+            if(prod - r->cons_cache == (_size))                                                         \
+                return UTL_CBF_FULL;                                                                    \
+        }                                                                                               \
+                                                                                                        \
+        r->items[prod & ((_size) - 1)] = *item;                                                         \
+        atomic_store_explicit(&r->prod, prod + 1, memory_order_release);                                \
+                                                                                                        \
+        return UTL_CBF_OK;                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline utl_cbf_status_t name##_pop(name##_t* r, type* item)                                  \
+    {                                                                                                   \
+        uint32_t cons = atomic_load_explicit(&r->cons, memory_order_relaxed);                           \
+                                                                                                        \
+        if(cons == r->prod_cache)                                                                       \
+        {                                                                                               \
+            r->prod_cache = atomic_load_explicit(&r->prod, memory_order_acquire);                       \
+            if(cons == r->prod_cache)                                                                   \
+                return UTL_CBF_EMPTY;                                                                   \
+        }                                                                                               \
+                                                                                                        \
+        *item = r->items[cons & ((_size) - 1)];                                                         \
+        atomic_store_explicit(&r->cons, cons + 1, memory_order_release);                                \
+                                                                                                        \
+        return UTL_CBF_OK;                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline uint32_t name##_count(name##_t* r)                                                    \
+    {                                                                                                   \
+        uint32_t cons = atomic_load_explicit(&r->cons, memory_order_acquire);                           \
+        return atomic_load_explicit(&r->prod, memory_order_acquire) - cons;                             \
+    }                                                                                                   \
+                                                                                                        \
+    _Static_assert(UTL_CBF_SIZE_IS_VALID(_size), "utl_ring: size must be a power of 2 (" #name ")")
+
+/**
+ @brief Define o tipo e as funções de @ref UTL_RING_DEFINE_TYPED e declara uma instância estática @p name.
+*/
+#define UTL_RING_DECLARE_TYPED(name, type, _size) \
+    UTL_RING_DEFINE_TYPED(name, type, _size);     \
+    static name##_t name
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "hal_crc.h"
+#include "utl_crc.h"
+
+#define TEST_CRC_MAX_LEN 4096
+#define TEST_CRC_NUM_BUFFERS 200
+
+// especificações de referência na mesma ordem de hal_crc_type_t
+static const utl_crc_spec_t* test_specs[HAL_CRC_NUM_TYPES] = {
+    [HAL_CRC_CRC16_CCITT] = &utl_crc16_ccitt_spec,
+    [HAL_CRC_CRC16_MODBUS] = &utl_crc16_modbus_spec,
+    [HAL_CRC_CRC32] = &utl_crc32_spec,
+    [HAL_CRC_CRC32C] = &utl_crc32c_spec,
+};
+
+static void test_vectors(void)
+{
+    const uint8_t check[] = "123456789";
+
+    assert(hal_crc(HAL_CRC_CRC16_CCITT, check, sizeof(check) - 1) == 0x29B1);
+    assert(hal_crc(HAL_CRC_CRC16_MODBUS, check, sizeof(check) - 1) == 0x4B37);
+    assert(hal_crc(HAL_CRC_CRC32, check, sizeof(check) - 1) == 0xCBF43926);
+    assert(hal_crc(HAL_CRC_CRC32C, check, sizeof(check) - 1) == 0xE3069283);
+
+    for(hal_crc_type_t type = 0; type < HAL_CRC_NUM_TYPES; type++)
+    {
+        assert(hal_crc_initial(type) == utl_crc_final(test_specs[type], utl_crc_init(test_specs[type])));
+        assert(hal_crc(type, check, 0) == hal_crc_initial(type));
+    }
+
+    printf("CRC vector test passed!\n");
+}
+
+static void test_random(void)
+{
+    static uint8_t data[TEST_CRC_MAX_LEN + 8];
+
+    for(size_t n = 0; n < TEST_CRC_NUM_BUFFERS; n++)
+    {
+        // inícios desalinhados e tamanhos que deixam sobras de 1 a 3 bytes nas palavras
+        size_t off = (size_t) rand() % 8;
+        size_t len = (size_t) rand() % (TEST_CRC_MAX_LEN + 1);
+        size_t cut = len ? (size_t) rand() % len : 0;
+
+        for(size_t pos = 0; pos < len; pos++)
+            data[off + pos] = (uint8_t) rand();
+
+        for(hal_crc_type_t type = 0; type < HAL_CRC_NUM_TYPES; type++)
+        {
+            uint32_t ref = utl_crc_data(test_specs[type], data + off, len);
+
+            assert(hal_crc(type, data + off, len) == ref);
+
+            // em pedaços, com o resultado anterior passado adiante
+            uint32_t crc = hal_crc(type, data + off, cut);
+            assert(hal_crc_data(type, data + off + cut, len - cut, crc) == ref);
+        }
+    }
+
+    printf("CRC random buffer test passed!\n");
+}
+
+int main(void)
+{
+    hal_crc_init();
+
+    test_vectors();
+    test_random();
+
+    hal_crc_deinit();
+
+    return 0;
+}
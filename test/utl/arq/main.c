@@ -0,0 +1,323 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "hal.h"
+#include "utl_arq.h"
+
+// Teste ponta a ponta do utl_arq sobre as portas PTY do port Linux: UART0 e UART1 são ligadas por uma
+// thread ponte, que lê o lado escravo de cada PTY e escreve no outro, corrompendo bytes quando pedido.
+
+#define TEST_ARQ_NUM_BYTES (256 * 1024)
+#define TEST_ARQ_LOSSY_NUM_BYTES (64 * 1024)
+#define TEST_ARQ_TIMEOUT_MS 60000
+#define TEST_ARQ_DRAIN_MS 100
+#define TEST_ARQ_BRIDGE_CHUNK 256
+// ganho mínimo de vazão da janela cheia sobre o stop-and-wait no enlace com perdas
+#define TEST_ARQ_WINDOW_SPEEDUP 2
+
+typedef struct test_end_s
+{
+    utl_arq_t arq;
+    hal_uart_dev_t dev;
+    uint8_t dir;
+    size_t sent;
+    size_t received;
+} test_end_t;
+
+static test_end_t ends[2];
+static int bridge_fd[2];
+static pthread_t bridge_thread;
+static _Atomic bool bridge_run;
+// um byte corrompido a cada bridge_err_rate bytes, em média (0: enlace limpo)
+static _Atomic uint32_t bridge_err_rate;
+static _Atomic uint32_t bridge_errors;
+
+static hal_uart_config_t uart_cfg = {
+    .baud_rate = HAL_UART_BAUD_RATE_115200,
+    .parity = HAL_UART_PARITY_NONE,
+    .stop_bits = HAL_UART_STOP_BITS_1,
+    .flow_control = HAL_UART_FLOW_CONTROL_NONE,
+    .interrupt_callback = 0,
+};
+
+static uint32_t test_rand(uint32_t* state)
+{
+    // xorshift32, reprodutível entre execuções
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void* bridge_task(void* arg)
+{
+    struct pollfd fds[2] = {{.fd = bridge_fd[0], .events = POLLIN}, {.fd = bridge_fd[1], .events = POLLIN}};
+    uint8_t chunk[TEST_ARQ_BRIDGE_CHUNK];
+    uint32_t seed = 0x12345678;
+
+    (void) arg;
+
+    while(atomic_load(&bridge_run))
+    {
+        if(poll(fds, 2, 10) <= 0)
+            continue;
+
+        for(int n = 0; n < 2; n++)
+        {
+            if(!(fds[n].revents & POLLIN))
+                continue;
+
+            ssize_t len = read(bridge_fd[n], chunk, sizeof(chunk));
+            uint32_t rate = atomic_load(&bridge_err_rate);
+
+            for(ssize_t pos = 0; rate && pos < len; pos++)
+            {
+                if(test_rand(&seed) % rate == 0)
+                {
+                    chunk[pos] ^= (uint8_t) (1u << (test_rand(&seed) % 8));
+                    atomic_fetch_add(&bridge_errors, 1);
+                }
+            }
+
+            for(ssize_t pos = 0; pos < len;)
+            {
+                ssize_t w = write(bridge_fd[n ^ 1], chunk + pos, (size_t) (len - pos));
+                if(w > 0)
+                    pos += w;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static int bridge_open(int port)
+{
+    char name[256];
+    struct termios tty;
+    int fd;
+
+    snprintf(name, sizeof(name), "%s/uart%d", UART_PTY_LINK_DIR, port);
+    fd = open(name, O_RDWR | O_NOCTTY);
+    assert(fd >= 0);
+    assert(tcgetattr(fd, &tty) == 0);
+    cfmakeraw(&tty);
+    assert(tcsetattr(fd, TCSANOW, &tty) == 0);
+
+    return fd;
+}
+
+static uint8_t test_pattern(uint8_t dir, size_t pos)
+{
+    // inclui zeros, para exercitar a codificação COBS
+    return (uint8_t) ((pos * 7 + (pos >> 8) + dir * 101) % 251);
+}
+
+static void test_end_pump(test_end_t* e, size_t total, bool* progress)
+{
+    uint8_t buf[UTL_ARQ_PAYLOAD_MAX];
+    size_t len;
+
+    while(e->sent < total)
+    {
+        // mensagens de tamanhos variados, de 1 byte ao máximo
+        len = 1 + (e->sent / 3) % UTL_ARQ_PAYLOAD_MAX;
+        if(len > total - e->sent)
+            len = total - e->sent;
+        for(size_t n = 0; n < len; n++)
+            buf[n] = test_pattern(e->dir, e->sent + n);
+        if(utl_arq_send(&e->arq, buf, len) != UTL_ARQ_OK)
+            break;
+        e->sent += len;
+        *progress = true;
+    }
+
+    assert(utl_arq_poll(&e->arq) == UTL_ARQ_OK);
+
+    while(utl_arq_recv(&e->arq, buf, sizeof(buf), &len) == UTL_ARQ_OK)
+    {
+        for(size_t n = 0; n < len; n++)
+            assert(buf[n] == test_pattern(e->dir ^ 1, e->received + n));
+        e->received += len;
+        *progress = true;
+    }
+}
+
+// transferência simultânea nos dois sentidos, retorna a duração em ms
+static uint32_t test_transfer(const utl_arq_config_t* cfg, size_t total, utl_arq_stats_t stats[2])
+{
+    uint32_t start;
+
+    for(int n = 0; n < 2; n++)
+    {
+        assert(utl_arq_init(&ends[n].arq, ends[n].dev, cfg) == UTL_ARQ_OK);
+        ends[n].sent = 0;
+        ends[n].received = 0;
+    }
+
+    start = hal_cpu_time_get_ms();
+    while(ends[0].received < total || ends[1].received < total || utl_arq_tx_pending(&ends[0].arq) ||
+          utl_arq_tx_pending(&ends[1].arq))
+    {
+        bool progress = false;
+
+        test_end_pump(&ends[0], total, &progress);
+        test_end_pump(&ends[1], total, &progress);
+        if(!progress)
+            usleep(100);
+        assert(hal_cpu_time_elapsed_get_ms(start) < TEST_ARQ_TIMEOUT_MS);
+    }
+
+    uint32_t elapsed = hal_cpu_time_elapsed_get_ms(start);
+
+    // esvazia o enlace (últimos ACKs) antes da próxima transferência
+    for(uint32_t drain = hal_cpu_time_get_ms(); hal_cpu_time_elapsed_get_ms(drain) < TEST_ARQ_DRAIN_MS;)
+    {
+        utl_arq_poll(&ends[0].arq);
+        utl_arq_poll(&ends[1].arq);
+        usleep(1000);
+    }
+
+    utl_arq_stats_get(&ends[0].arq, &stats[0]);
+    utl_arq_stats_get(&ends[1].arq, &stats[1]);
+
+    return elapsed;
+}
+
+static void test_stats_print(const char* name, uint32_t ms, size_t total, const utl_arq_stats_t* stats)
+{
+    printf("%s: %zu bytes each way in %u ms, %u frames, %u retransmits, %u rx errors, %u nacks\n", name, total,
+           (unsigned) ms, (unsigned) (stats[0].tx_frames + stats[1].tx_frames),
+           (unsigned) (stats[0].tx_retransmits + stats[1].tx_retransmits),
+           (unsigned) (stats[0].rx_errors + stats[1].rx_errors),
+           (unsigned) (stats[0].nacks_sent + stats[1].nacks_sent));
+}
+
+static void test_clean(void)
+{
+    utl_arq_config_t cfg = {.window = UTL_ARQ_WINDOW_MAX, .rto_ms = 200, .max_retries = 0};
+    utl_arq_stats_t stats[2];
+    uint32_t ms;
+
+    atomic_store(&bridge_err_rate, 0);
+    ms = test_transfer(&cfg, TEST_ARQ_NUM_BYTES, stats);
+    test_stats_print("clean", ms, TEST_ARQ_NUM_BYTES, stats);
+
+    // sem corrupção nada se perde: com o buffer de RX do port cheio, os bytes esperam no PTY
+    for(int n = 0; n < 2; n++)
+    {
+        assert(stats[n].rx_errors == 0);
+        assert(stats[n].rx_frames == stats[n ^ 1].tx_frames);
+    }
+
+    printf("Clean link test passed!\n");
+}
+
+static void test_lossy(void)
+{
+    utl_arq_stats_t stats[2];
+    uint32_t ms[2];
+
+    atomic_store(&bridge_err_rate, 2000);
+    atomic_store(&bridge_errors, 0);
+
+    // janela cheia (ms[0]) x stop-and-wait (ms[1]) com as mesmas perdas
+    for(int run = 0; run < 2; run++)
+    {
+        uint8_t window = run == 0 ? UTL_ARQ_WINDOW_MAX : 1;
+        utl_arq_config_t cfg = {.window = window, .rto_ms = 50, .max_retries = 0};
+        char name[32];
+
+        ms[run] = test_transfer(&cfg, TEST_ARQ_LOSSY_NUM_BYTES, stats);
+        snprintf(name, sizeof(name), "lossy window %u", window);
+        test_stats_print(name, ms[run], TEST_ARQ_LOSSY_NUM_BYTES, stats);
+
+        assert(stats[0].rx_errors + stats[1].rx_errors > 0);
+        assert(stats[0].tx_retransmits + stats[1].tx_retransmits > 0);
+    }
+
+    // a janela mantém o enlace ocupado enquanto um quadro perdido espera a retransmissão: com folga, deve
+    // ser bem mais rápida que o stop-and-wait, que fica parado um RTO a cada perda
+    assert(TEST_ARQ_WINDOW_SPEEDUP * ms[0] < ms[1]);
+
+    atomic_store(&bridge_err_rate, 0);
+    printf("Lossy link test passed! (%u bytes corrupted)\n", (unsigned) atomic_load(&bridge_errors));
+}
+
+static void test_errors(void)
+{
+    utl_arq_config_t cfg = {.window = UTL_ARQ_WINDOW_MAX, .rto_ms = 10, .max_retries = 0};
+    utl_arq_t arq;
+    uint8_t buf[UTL_ARQ_PAYLOAD_MAX + 1] = {0};
+    size_t len;
+
+    assert(utl_arq_init(&arq, NULL, &cfg) == UTL_ARQ_ERROR);
+    cfg.window = 0;
+    assert(utl_arq_init(&arq, ends[0].dev, &cfg) == UTL_ARQ_ERROR);
+    cfg.window = UTL_ARQ_WINDOW_MAX + 1;
+    assert(utl_arq_init(&arq, ends[0].dev, &cfg) == UTL_ARQ_ERROR);
+    cfg.window = UTL_ARQ_WINDOW_MAX;
+    cfg.rto_ms = 0;
+    assert(utl_arq_init(&arq, ends[0].dev, &cfg) == UTL_ARQ_ERROR);
+
+    // sem ninguém do outro lado: a janela enche e o enlace cai após max_retries
+    atomic_store(&bridge_run, false);
+    pthread_join(bridge_thread, NULL);
+
+    cfg.rto_ms = 10;
+    cfg.max_retries = 3;
+    assert(utl_arq_init(&arq, ends[0].dev, &cfg) == UTL_ARQ_OK);
+    assert(utl_arq_send(&arq, buf, 0) == UTL_ARQ_ERROR);
+    assert(utl_arq_send(&arq, buf, sizeof(buf)) == UTL_ARQ_ERROR);
+    for(uint8_t n = 0; n < UTL_ARQ_WINDOW_MAX; n++)
+        assert(utl_arq_send(&arq, buf, 1) == UTL_ARQ_OK);
+    assert(utl_arq_send(&arq, buf, 1) == UTL_ARQ_BUSY);
+    assert(utl_arq_tx_pending(&arq) == UTL_ARQ_WINDOW_MAX);
+    assert(utl_arq_recv(&arq, buf, sizeof(buf), &len) == UTL_ARQ_EMPTY && len == 0);
+
+    uint32_t start = hal_cpu_time_get_ms();
+    while(utl_arq_poll(&arq) == UTL_ARQ_OK)
+    {
+        assert(hal_cpu_time_elapsed_get_ms(start) < 1000);
+        usleep(1000);
+    }
+    assert(utl_arq_send(&arq, buf, 1) == UTL_ARQ_ERROR);
+
+    printf("Error handling test passed!\n");
+}
+
+int main(void)
+{
+    hal_cpu_init();
+    hal_crc_init();
+    hal_uart_init();
+
+    for(int n = 0; n < 2; n++)
+    {
+        ends[n].dev = hal_uart_open((hal_uart_port_t) n, &uart_cfg);
+        assert(ends[n].dev != NULL);
+        ends[n].dir = (uint8_t) n;
+        bridge_fd[n] = bridge_open(n);
+    }
+
+    atomic_store(&bridge_run, true);
+    pthread_create(&bridge_thread, NULL, bridge_task, NULL);
+
+    test_clean();
+    test_lossy();
+    test_errors();
+
+    // as threads de RX do port ficam bloqueadas na leitura dos PTYs, o fim do processo as encerra
+    return 0;
+}
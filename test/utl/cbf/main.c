@@ -0,0 +1,786 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utl_cbf.h"
+#include "utl_mpsc.h"
+#include "utl_rec.h"
+#include "utl_ring.h"
+
+#define TEST_CBF_SIZE 64
+#define TEST_CBF_LARGE_SIZE (8 * 1024 * 1024)
+#define TEST_CBF_NUM_BYTES (4 * 1024 * 1024)
+#define TEST_CBF_WAIT_NUM_BYTES (256 * 1024)
+#define TEST_CBF_WAIT_TIMEOUT_MS 20
+#define TEST_CBF_OVW_NUM_BYTES (1024 * 1024)
+#define TEST_REC_SIZE 256
+#define TEST_REC_NUM_RECORDS 200000
+#define TEST_RING_SIZE 8
+#define TEST_RING_NUM_ITEMS 500000
+#define TEST_MPSC_SIZE 16
+#define TEST_MPSC_NUM_PRODUCERS 4
+#define TEST_MPSC_NUM_RECORDS 100000
+
+UTL_CBF_DECLARE(cb, TEST_CBF_SIZE);
+UTL_MPSC_DECLARE(q, TEST_MPSC_SIZE);
+UTL_CBF_DECLARE(rb, TEST_REC_SIZE);
+
+typedef struct test_sample_s
+{
+    uint32_t seq;
+    int32_t latitude;
+    int32_t longitude;
+    char tag[6];
+} test_sample_t;
+
+UTL_RING_DECLARE_TYPED(samples, test_sample_t, TEST_RING_SIZE);
+
+static void test_single_thread(void)
+{
+    uint8_t c;
+
+    utl_cbf_flush(&cb);
+    assert(utl_cbf_get(&cb, &c) == UTL_CBF_EMPTY);
+
+    for(size_t n = 0; n < TEST_CBF_SIZE; n++)
+        assert(utl_cbf_put(&cb, (uint8_t) n) == UTL_CBF_OK);
+
+    assert(utl_cbf_put(&cb, 0xAA) == UTL_CBF_FULL);
+    assert(utl_cbf_bytes_available(&cb) == TEST_CBF_SIZE);
+
+    for(size_t n = 0; n < TEST_CBF_SIZE; n++)
+    {
+        assert(utl_cbf_get(&cb, &c) == UTL_CBF_OK);
+        assert(c == (uint8_t) n);
+    }
+
+    assert(utl_cbf_get(&cb, &c) == UTL_CBF_EMPTY);
+    assert(utl_cbf_bytes_available(&cb) == 0);
+
+    // flush deve descartar o que foi publicado
+    utl_cbf_put(&cb, 1);
+    utl_cbf_put(&cb, 2);
+    utl_cbf_flush(&cb);
+    assert(utl_cbf_bytes_available(&cb) == 0);
+    assert(utl_cbf_get(&cb, &c) == UTL_CBF_EMPTY);
+
+    printf("Single thread test passed!\n");
+}
+
+static void test_bulk(void)
+{
+    uint8_t src[TEST_CBF_SIZE * 2];
+    uint8_t dst[TEST_CBF_SIZE * 2];
+
+    for(size_t n = 0; n < sizeof(src); n++)
+        src[n] = (uint8_t) (n + 1);
+
+    utl_cbf_flush(&cb);
+
+    // escrita maior que o espaço livre é truncada
+    assert(utl_cbf_write(&cb, src, sizeof(src)) == TEST_CBF_SIZE);
+    assert(utl_cbf_write(&cb, src, 1) == 0);
+    assert(utl_cbf_read(&cb, dst, sizeof(dst)) == TEST_CBF_SIZE);
+    assert(memcmp(src, dst, TEST_CBF_SIZE) == 0);
+    assert(utl_cbf_read(&cb, dst, 1) == 0);
+
+    // percorre todas as posições de retorno possíveis
+    for(size_t offset = 0; offset <= TEST_CBF_SIZE; offset++)
+    {
+        for(size_t len = 1; len <= TEST_CBF_SIZE; len++)
+        {
+            assert(utl_cbf_write(&cb, src + offset, len) == len);
+            assert(utl_cbf_bytes_available(&cb) == len);
+            memset(dst, 0, sizeof(dst));
+            assert(utl_cbf_read(&cb, dst, len) == len);
+            assert(memcmp(src + offset, dst, len) == 0);
+        }
+        utl_cbf_put(&cb, 0);
+        utl_cbf_get(&cb, dst);
+    }
+
+    printf("Bulk test passed!\n");
+}
+
+static void test_zero_copy(void)
+{
+    uint8_t* wptr;
+    const uint8_t* rptr;
+    size_t len;
+    uint8_t c;
+
+    utl_cbf_init(&cb, cbbuffer, TEST_CBF_SIZE);
+
+    // desloca os índices para perto do fim do buffer
+    for(size_t n = 0; n < TEST_CBF_SIZE - 10; n++)
+    {
+        utl_cbf_put(&cb, 0);
+        utl_cbf_get(&cb, &c);
+    }
+
+    wptr = utl_cbf_write_reserve(&cb, &len);
+    assert(wptr && len == 10);
+    memset(wptr, 0x55, len);
+    assert(utl_cbf_write_commit(&cb, len) == UTL_CBF_OK);
+
+    // o restante do espaço livre fica no início do buffer
+    wptr = utl_cbf_write_reserve(&cb, &len);
+    assert(wptr && len == TEST_CBF_SIZE - 10);
+    memset(wptr, 0xAA, len);
+    assert(utl_cbf_write_commit(&cb, len + 1) == UTL_CBF_FULL);
+    assert(utl_cbf_write_commit(&cb, len) == UTL_CBF_OK);
+    assert(utl_cbf_write_reserve(&cb, &len) == NULL && len == 0);
+
+    rptr = utl_cbf_read_peek(&cb, &len);
+    assert(rptr && len == 10 && rptr[0] == 0x55 && rptr[9] == 0x55);
+    assert(utl_cbf_read_release(&cb, 5) == UTL_CBF_OK);
+    rptr = utl_cbf_read_peek(&cb, &len);
+    assert(rptr && len == 5);
+    assert(utl_cbf_read_release(&cb, len) == UTL_CBF_OK);
+
+    rptr = utl_cbf_read_peek(&cb, &len);
+    assert(rptr && len == TEST_CBF_SIZE - 10 && rptr[0] == 0xAA);
+    assert(utl_cbf_read_release(&cb, len + 1) == UTL_CBF_EMPTY);
+    assert(utl_cbf_read_release(&cb, len) == UTL_CBF_OK);
+    assert(utl_cbf_read_peek(&cb, &len) == NULL && len == 0);
+
+    printf("Zero-copy test passed!\n");
+}
+
+static void test_large(void)
+{
+    utl_cbf_t big;
+    uint32_t size = TEST_CBF_LARGE_SIZE;
+    uint8_t* area = malloc(size);
+    uint8_t chunk[1000];
+    uint8_t c;
+
+    assert(area);
+    assert(utl_cbf_init(&big, area, 1000) == UTL_CBF_ERROR);
+    assert(utl_cbf_init(&big, area, 0) == UTL_CBF_ERROR);
+    assert(utl_cbf_init(&big, area, size) == UTL_CBF_OK);
+
+    // enche o buffer inteiro, sem posição reservada
+    for(uint32_t n = 0; n < size; n += sizeof(chunk))
+    {
+        memset(chunk, (uint8_t) (n / sizeof(chunk)), sizeof(chunk));
+        utl_cbf_write(&big, chunk, sizeof(chunk));
+    }
+    assert(utl_cbf_bytes_available(&big) == size);
+    assert(utl_cbf_put(&big, 0) == UTL_CBF_FULL);
+    utl_cbf_flush(&big);
+    assert(utl_cbf_bytes_available(&big) == 0);
+
+    // contadores livres atravessando o limite de 32 bits
+    atomic_store(&big.prod, UINT32_MAX - 3);
+    atomic_store(&big.cons, UINT32_MAX - 3);
+    big.prod_cache = big.cons_cache = UINT32_MAX - 3;
+    for(uint8_t n = 0; n < 8; n++)
+        assert(utl_cbf_put(&big, n) == UTL_CBF_OK);
+    assert(utl_cbf_bytes_available(&big) == 8);
+    for(uint8_t n = 0; n < 8; n++)
+    {
+        assert(utl_cbf_get(&big, &c) == UTL_CBF_OK);
+        assert(c == n);
+    }
+    assert(utl_cbf_get(&big, &c) == UTL_CBF_EMPTY);
+
+    free(area);
+
+    printf("Large buffer test passed!\n");
+}
+
+static void test_mirror(void)
+{
+    utl_cbf_t mb;
+    uint32_t size = (uint32_t) sysconf(_SC_PAGESIZE);
+    uint8_t src[256];
+    const uint8_t* rptr;
+    uint8_t* wptr;
+    size_t len;
+    uint8_t c;
+
+    assert(utl_cbf_mirror_init(&mb, size / 2) == UTL_CBF_ERROR);
+    assert(utl_cbf_mirror_init(&mb, size) == UTL_CBF_OK);
+
+    for(size_t n = 0; n < sizeof(src); n++)
+        src[n] = (uint8_t) (n ^ 0x5A);
+
+    // a segunda metade é o mesmo conteúdo da primeira
+    mb.buffer[0] = 0x12;
+    assert(mb.buffer[size] == 0x12);
+
+    // leva os índices para perto do fim da área de dados
+    atomic_store(&mb.prod, size - 100);
+    atomic_store(&mb.cons, size - 100);
+    mb.prod_cache = mb.cons_cache = size - 100;
+
+    // um registro que atravessa o retorno é lido de forma contígua
+    assert(utl_cbf_write(&mb, src, sizeof(src)) == sizeof(src));
+    rptr = utl_cbf_read_peek(&mb, &len);
+    assert(rptr && len == sizeof(src) && memcmp(rptr, src, sizeof(src)) == 0);
+    assert(utl_cbf_read_release(&mb, len) == UTL_CBF_OK);
+
+    // todo o espaço livre pode ser reservado de uma vez
+    wptr = utl_cbf_write_reserve(&mb, &len);
+    assert(wptr && len == size);
+    memcpy(wptr, src, sizeof(src));
+    assert(utl_cbf_write_commit(&mb, sizeof(src)) == UTL_CBF_OK);
+    assert(utl_cbf_read(&mb, &c, 1) == 1 && c == src[0]);
+
+    utl_cbf_mirror_deinit(&mb);
+
+    printf("Mirror test passed!\n");
+}
+
+static void test_overwrite_stats(void)
+{
+    utl_cbf_t ob;
+    uint8_t area[TEST_CBF_SIZE];
+    uint8_t src[TEST_CBF_SIZE * 2];
+    uint8_t dst[TEST_CBF_SIZE * 2];
+    utl_cbf_stats_t stats;
+    uint8_t c;
+
+    for(size_t n = 0; n < sizeof(src); n++)
+        src[n] = (uint8_t) n;
+
+    // modo normal: bytes recusados são contados
+    utl_cbf_init(&ob, area, TEST_CBF_SIZE);
+    assert(utl_cbf_write(&ob, src, TEST_CBF_SIZE - 4) == TEST_CBF_SIZE - 4);
+    assert(utl_cbf_write(&ob, src, 10) == 4);
+    assert(utl_cbf_put(&ob, 0) == UTL_CBF_FULL);
+    utl_cbf_stats_get(&ob, &stats);
+    assert(stats.total == TEST_CBF_SIZE && stats.dropped == 7);
+    assert(!UTL_CBF_STATS_ENABLED || stats.high_water == TEST_CBF_SIZE);
+
+    // a ocupação também é amostrada pelo consumidor quando ele relê o índice do produtor
+    utl_cbf_init(&ob, area, TEST_CBF_SIZE);
+    assert(utl_cbf_write(&ob, src, 5) == 5);
+    assert(utl_cbf_get(&ob, &c) == UTL_CBF_OK);
+    utl_cbf_stats_get(&ob, &stats);
+    assert(!UTL_CBF_STATS_ENABLED || stats.high_water == 5);
+
+    // sobrescrita: os mais antigos dão lugar aos novos
+    utl_cbf_init(&ob, area, TEST_CBF_SIZE);
+    utl_cbf_overwrite_set(&ob, true);
+    assert(utl_cbf_write(&ob, src, TEST_CBF_SIZE) == TEST_CBF_SIZE);
+    assert(utl_cbf_put(&ob, 0xAA) == UTL_CBF_OK);
+    assert(utl_cbf_write(&ob, src, 3) == 3);
+    assert(utl_cbf_bytes_available(&ob) == TEST_CBF_SIZE);
+    assert(utl_cbf_get(&ob, &c) == UTL_CBF_OK && c == 4);
+    assert(utl_cbf_read(&ob, dst, TEST_CBF_SIZE - 5) == TEST_CBF_SIZE - 5);
+    assert(memcmp(dst, src + 5, TEST_CBF_SIZE - 5) == 0);
+    assert(utl_cbf_read(&ob, dst, sizeof(dst)) == 4);
+    assert(dst[0] == 0xAA && dst[1] == 0 && dst[3] == 2);
+    utl_cbf_stats_get(&ob, &stats);
+    assert(stats.dropped == 4 && stats.total == TEST_CBF_SIZE + 4);
+
+    // bloco maior que o buffer: só os últimos bytes sobrevivem
+    assert(utl_cbf_write(&ob, src, sizeof(src)) == sizeof(src));
+    assert(utl_cbf_read(&ob, dst, sizeof(dst)) == TEST_CBF_SIZE);
+    assert(memcmp(dst, src + TEST_CBF_SIZE, TEST_CBF_SIZE) == 0);
+
+    // uma região lida com peek e sobrescrita antes da liberação é rejeitada
+    const uint8_t* rptr;
+    size_t len;
+    utl_cbf_write(&ob, src, 8);
+    rptr = utl_cbf_read_peek(&ob, &len);
+    assert(rptr && len == 8);
+    utl_cbf_write(&ob, src, TEST_CBF_SIZE);
+    assert(utl_cbf_read_release(&ob, len) == UTL_CBF_ERROR);
+    size_t total = 0;
+    while((rptr = utl_cbf_read_peek(&ob, &len)) != NULL)
+    {
+        assert(memcmp(rptr, src + total, len) == 0);
+        assert(utl_cbf_read_release(&ob, len) == UTL_CBF_OK);
+        total += len;
+    }
+    assert(total == TEST_CBF_SIZE);
+    utl_cbf_write(&ob, src, 8);
+    utl_cbf_flush(&ob);
+    assert(utl_cbf_bytes_available(&ob) == 0);
+
+    printf("Overwrite and stats test passed!\n");
+}
+
+static void* overwrite_producer_thread(void* arg)
+{
+    utl_cbf_t* ob = arg;
+
+    for(uint32_t n = 0; n < TEST_CBF_OVW_NUM_BYTES; n++)
+        assert(utl_cbf_put(ob, (uint8_t) n) == UTL_CBF_OK);
+
+    return NULL;
+}
+
+static void test_overwrite_spsc(void)
+{
+    utl_cbf_t ob;
+    uint8_t area[TEST_CBF_SIZE];
+    uint8_t dst[TEST_CBF_SIZE];
+    utl_cbf_stats_t stats;
+    pthread_t producer;
+    uint32_t received = 0;
+    uint8_t last = 0;
+    size_t len;
+
+    utl_cbf_init(&ob, area, TEST_CBF_SIZE);
+    utl_cbf_overwrite_set(&ob, true);
+    pthread_create(&producer, NULL, overwrite_producer_thread, &ob);
+
+    // o produtor nunca é bloqueado; cada leitura deve ser um trecho contíguo da sequência, sem dados rasgados
+    do
+    {
+        utl_cbf_stats_get(&ob, &stats);
+        while((len = utl_cbf_read(&ob, dst, sizeof(dst))) > 0)
+        {
+            for(size_t pos = 1; pos < len; pos++)
+                assert(dst[pos] == (uint8_t) (dst[0] + pos));
+            last = dst[len - 1];
+            received += (uint32_t) len;
+        }
+    } while(stats.total != TEST_CBF_OVW_NUM_BYTES);
+
+    pthread_join(producer, NULL);
+    utl_cbf_stats_get(&ob, &stats);
+    assert(received + stats.dropped == TEST_CBF_OVW_NUM_BYTES);
+    assert(last == (uint8_t) (TEST_CBF_OVW_NUM_BYTES - 1));
+
+    printf("Overwrite SPSC test passed!\n");
+}
+
+static void* producer_thread(void* arg)
+{
+    (void) arg;
+
+    for(uint32_t n = 0; n < TEST_CBF_NUM_BYTES;)
+    {
+        if(utl_cbf_put(&cb, (uint8_t) (n * 7)) == UTL_CBF_OK)
+            n++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void test_spsc(void)
+{
+    pthread_t producer;
+    uint8_t c;
+
+    utl_cbf_flush(&cb);
+    pthread_create(&producer, NULL, producer_thread, NULL);
+
+    for(uint32_t n = 0; n < TEST_CBF_NUM_BYTES;)
+    {
+        if(utl_cbf_get(&cb, &c) == UTL_CBF_OK)
+        {
+            assert(c == (uint8_t) (n * 7));
+            n++;
+        }
+        else
+            sched_yield();
+    }
+
+    pthread_join(producer, NULL);
+    assert(utl_cbf_bytes_available(&cb) == 0);
+    utl_cbf_wait_set(&cb, false);
+
+    printf("SPSC test passed!\n");
+}
+
+static uint64_t time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+static void* wait_producer_thread(void* arg)
+{
+    (void) arg;
+
+    for(uint32_t n = 0; n < TEST_CBF_WAIT_NUM_BYTES; n++)
+        assert(utl_cbf_put_wait(&cb, (uint8_t) (n * 3), UTL_CBF_WAIT_FOREVER) == UTL_CBF_OK);
+
+    return NULL;
+}
+
+static void test_wait(void)
+{
+    pthread_t producer;
+    uint8_t dst[TEST_CBF_SIZE];
+    uint64_t start;
+    uint8_t c;
+
+    utl_cbf_flush(&cb);
+
+    // sem utl_cbf_wait_set as funções de espera não bloqueiam
+    assert(utl_cbf_get_wait(&cb, &c, UTL_CBF_WAIT_FOREVER) == UTL_CBF_ERROR);
+    assert(utl_cbf_put_wait(&cb, 0, UTL_CBF_WAIT_FOREVER) == UTL_CBF_ERROR);
+    assert(utl_cbf_read_wait(&cb, dst, sizeof(dst), UTL_CBF_WAIT_FOREVER) == 0);
+    utl_cbf_wait_set(&cb, true);
+
+    // vazio: o consumidor dorme até o timeout
+    start = time_ms();
+    assert(utl_cbf_get_wait(&cb, &c, TEST_CBF_WAIT_TIMEOUT_MS) == UTL_CBF_TMROUT);
+    assert(time_ms() - start >= TEST_CBF_WAIT_TIMEOUT_MS);
+    assert(utl_cbf_read_wait(&cb, dst, sizeof(dst), 0) == 0);
+
+    // cheio: o produtor dorme até o timeout
+    for(size_t n = 0; n < TEST_CBF_SIZE; n++)
+        utl_cbf_put(&cb, (uint8_t) n);
+    start = time_ms();
+    assert(utl_cbf_put_wait(&cb, 0, TEST_CBF_WAIT_TIMEOUT_MS) == UTL_CBF_TMROUT);
+    assert(time_ms() - start >= TEST_CBF_WAIT_TIMEOUT_MS);
+    assert(utl_cbf_get_wait(&cb, &c, 0) == UTL_CBF_OK && c == 0);
+    assert(utl_cbf_put_wait(&cb, 0, 0) == UTL_CBF_OK);
+    utl_cbf_flush(&cb);
+
+    // os dois lados dormem e se acordam mutuamente
+    pthread_create(&producer, NULL, wait_producer_thread, NULL);
+
+    for(uint32_t n = 0; n < TEST_CBF_WAIT_NUM_BYTES;)
+    {
+        if(n % 2)
+        {
+            assert(utl_cbf_get_wait(&cb, &c, UTL_CBF_WAIT_FOREVER) == UTL_CBF_OK);
+            assert(c == (uint8_t) (n * 3));
+            n++;
+        }
+        else
+        {
+            size_t len = utl_cbf_read_wait(&cb, dst, sizeof(dst), UTL_CBF_WAIT_FOREVER);
+            assert(len > 0);
+            for(size_t pos = 0; pos < len; pos++, n++)
+                assert(dst[pos] == (uint8_t) (n * 3));
+        }
+    }
+
+    pthread_join(producer, NULL);
+    assert(utl_cbf_bytes_available(&cb) == 0);
+    utl_cbf_wait_set(&cb, false);
+
+    printf("Wait test passed!\n");
+}
+
+static void test_rec(void)
+{
+    uint8_t src[TEST_REC_SIZE];
+    uint8_t dst[TEST_REC_SIZE];
+    const uint8_t* rptr;
+    size_t len;
+
+    for(size_t n = 0; n < sizeof(src); n++)
+        src[n] = (uint8_t) (n * 5);
+
+    assert(utl_rec_peek(&rb, &len) == NULL && len == 0);
+    assert(utl_rec_release(&rb) == UTL_CBF_EMPTY);
+    assert(utl_rec_push(&rb, src, TEST_REC_SIZE - 1) == UTL_CBF_ERROR);
+
+    // registros de todos os tamanhos, passando várias vezes pelo ponto de retorno
+    for(size_t rec = 0; rec < 4 * TEST_REC_SIZE; rec++)
+    {
+        size_t n = rec % (TEST_REC_SIZE / 4);
+        assert(utl_rec_push(&rb, src, n) == UTL_CBF_OK);
+        assert(utl_rec_push(&rb, src + 1, n / 2) == UTL_CBF_OK);
+
+        rptr = utl_rec_peek(&rb, &len);
+        assert(rptr && len == n && memcmp(rptr, src, n) == 0);
+        assert(utl_rec_release(&rb) == UTL_CBF_OK);
+
+        if(n / 2 > 0)
+            assert(utl_rec_pop(&rb, dst, n / 2 - 1, &len) == UTL_CBF_ERROR);
+        assert(utl_rec_pop(&rb, dst, sizeof(dst), &len) == UTL_CBF_OK);
+        assert(len == n / 2 && memcmp(dst, src + 1, len) == 0);
+        assert(utl_rec_pop(&rb, dst, sizeof(dst), &len) == UTL_CBF_EMPTY);
+    }
+
+    // enche com registros vazios (só cabeçalho)
+    for(size_t n = 0; n < TEST_REC_SIZE / UTL_REC_HEADER_SIZE; n++)
+        assert(utl_rec_push(&rb, src, 0) == UTL_CBF_OK);
+    assert(utl_rec_push(&rb, src, 0) == UTL_CBF_FULL);
+    while(utl_rec_pop(&rb, dst, sizeof(dst), &len) == UTL_CBF_OK)
+        assert(len == 0);
+    assert(utl_cbf_bytes_available(&rb) == 0);
+
+    printf("Record test passed!\n");
+}
+
+static void* rec_producer_thread(void* arg)
+{
+    uint8_t rec[TEST_REC_SIZE / 2];
+
+    (void) arg;
+
+    for(uint32_t n = 0; n < TEST_REC_NUM_RECORDS;)
+    {
+        size_t len = sizeof(n) + n % (sizeof(rec) - sizeof(n));
+        memcpy(rec, &n, sizeof(n));
+        memset(rec + sizeof(n), (uint8_t) n, len - sizeof(n));
+
+        if(utl_rec_push(&rb, rec, len) == UTL_CBF_OK)
+            n++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void test_rec_spsc(void)
+{
+    pthread_t producer;
+    const uint8_t* rptr;
+    size_t len;
+    uint32_t seq;
+
+    utl_cbf_flush(&rb);
+    pthread_create(&producer, NULL, rec_producer_thread, NULL);
+
+    for(uint32_t n = 0; n < TEST_REC_NUM_RECORDS;)
+    {
+        if((rptr = utl_rec_peek(&rb, &len)) == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(&seq, rptr, sizeof(seq));
+        assert(seq == n);
+        assert(len == sizeof(n) + n % (TEST_REC_SIZE / 2 - sizeof(n)));
+        for(size_t pos = sizeof(seq); pos < len; pos++)
+            assert(rptr[pos] == (uint8_t) n);
+        assert(utl_rec_release(&rb) == UTL_CBF_OK);
+        n++;
+    }
+
+    pthread_join(producer, NULL);
+    assert(utl_cbf_bytes_available(&rb) == 0);
+
+    printf("Record SPSC test passed!\n");
+}
+
+static void* ring_producer_thread(void* arg)
+{
+    test_sample_t s = {.tag = "GPRMC"};
+
+    (void) arg;
+
+    for(s.seq = 0; s.seq < TEST_RING_NUM_ITEMS;)
+    {
+        s.latitude = (int32_t) s.seq * 3;
+        s.longitude = -(int32_t) s.seq;
+        if(samples_push(&samples, &s) == UTL_CBF_OK)
+            s.seq++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void test_ring_typed(void)
+{
+    pthread_t producer;
+    test_sample_t s = {0};
+
+    assert(samples_pop(&samples, &s) == UTL_CBF_EMPTY);
+    for(uint32_t n = 0; n < TEST_RING_SIZE; n++)
+    {
+        s.seq = n;
+        assert(samples_push(&samples, &s) == UTL_CBF_OK);
+    }
+    assert(samples_push(&samples, &s) == UTL_CBF_FULL);
+    assert(samples_count(&samples) == TEST_RING_SIZE);
+    for(uint32_t n = 0; n < TEST_RING_SIZE; n++)
+        assert(samples_pop(&samples, &s) == UTL_CBF_OK && s.seq == n);
+    assert(samples_pop(&samples, &s) == UTL_CBF_EMPTY);
+
+    samples_init(&samples);
+    pthread_create(&producer, NULL, ring_producer_thread, NULL);
+
+    for(uint32_t n = 0; n < TEST_RING_NUM_ITEMS;)
+    {
+        if(samples_pop(&samples, &s) != UTL_CBF_OK)
+        {
+            sched_yield();
+            continue;
+        }
+
+        assert(s.seq == n && s.latitude == (int32_t) n * 3 && s.longitude == -(int32_t) n);
+        assert(strcmp(s.tag, "GPRMC") == 0);
+        n++;
+    }
+
+    pthread_join(producer, NULL);
+    assert(samples_count(&samples) == 0);
+
+    printf("Typed ring test passed!\n");
+}
+
+static void* mpsc_producer_thread(void* arg)
+{
+    uint8_t tag = (uint8_t) (uintptr_t) arg;
+    uint8_t rec[UTL_MPSC_RECORD_SIZE];
+
+    for(uint32_t n = 0; n < TEST_MPSC_NUM_RECORDS;)
+    {
+        // registros de tamanho variável, com o número de sequência no início
+        size_t len = sizeof(n) + (n % (UTL_MPSC_RECORD_SIZE - sizeof(n) + 1));
+        memcpy(rec, &n, sizeof(n));
+        memset(rec + sizeof(n), tag, len - sizeof(n));
+
+        if(utl_mpsc_put(&q, tag, rec, len) == UTL_CBF_OK)
+            n++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void test_mpsc(void)
+{
+    pthread_t producers[TEST_MPSC_NUM_PRODUCERS];
+    uint32_t next[TEST_MPSC_NUM_PRODUCERS] = {0};
+    uint8_t rec[UTL_MPSC_RECORD_SIZE];
+    uint8_t tag;
+    size_t len;
+    uint32_t seq;
+
+    assert(utl_mpsc_get(&q, &tag, rec, &len) == UTL_CBF_EMPTY);
+    assert(utl_mpsc_put(&q, 0, rec, UTL_MPSC_RECORD_SIZE + 1) == UTL_CBF_ERROR);
+
+    // enche a fila numa única thread
+    for(uint32_t n = 0; n < TEST_MPSC_SIZE; n++)
+        assert(utl_mpsc_put(&q, (uint8_t) n, (uint8_t*) &n, sizeof(n)) == UTL_CBF_OK);
+    assert(utl_mpsc_put(&q, 0, rec, 1) == UTL_CBF_FULL);
+    assert(utl_mpsc_records_available(&q) == TEST_MPSC_SIZE);
+    for(uint32_t n = 0; n < TEST_MPSC_SIZE; n++)
+    {
+        assert(utl_mpsc_get(&q, &tag, rec, &len) == UTL_CBF_OK);
+        memcpy(&seq, rec, sizeof(seq));
+        assert(tag == n && len == sizeof(n) && seq == n);
+    }
+    assert(utl_mpsc_get(&q, &tag, rec, &len) == UTL_CBF_EMPTY);
+
+    for(uintptr_t n = 0; n < TEST_MPSC_NUM_PRODUCERS; n++)
+        pthread_create(&producers[n], NULL, mpsc_producer_thread, (void*) n);
+
+    // a ordem entre produtores é livre, mas cada produtor deve chegar em ordem
+    for(uint32_t total = 0; total < TEST_MPSC_NUM_PRODUCERS * TEST_MPSC_NUM_RECORDS;)
+    {
+        if(utl_mpsc_get(&q, &tag, rec, &len) != UTL_CBF_OK)
+        {
+            sched_yield();
+            continue;
+        }
+
+        assert(tag < TEST_MPSC_NUM_PRODUCERS);
+        memcpy(&seq, rec, sizeof(seq));
+        assert(seq == next[tag]);
+        assert(len == sizeof(seq) + (seq % (UTL_MPSC_RECORD_SIZE - sizeof(seq) + 1)));
+        for(size_t pos = sizeof(seq); pos < len; pos++)
+            assert(rec[pos] == tag);
+
+        next[tag]++;
+        total++;
+    }
+
+    for(size_t n = 0; n < TEST_MPSC_NUM_PRODUCERS; n++)
+        pthread_join(producers[n], NULL);
+
+    assert(utl_mpsc_records_available(&q) == 0);
+
+    printf("MPSC test passed!\n");
+}
+
+static void* mpsc_late_producer_thread(void* arg)
+{
+    uint8_t rec = 0xA5;
+
+    (void) arg;
+    usleep(TEST_CBF_WAIT_TIMEOUT_MS * 1000);
+    assert(utl_mpsc_put(&q, TEST_MPSC_NUM_PRODUCERS, &rec, sizeof(rec)) == UTL_CBF_OK);
+
+    return NULL;
+}
+
+static void test_mpsc_wait(void)
+{
+    pthread_t producers[TEST_MPSC_NUM_PRODUCERS];
+    uint32_t next[TEST_MPSC_NUM_PRODUCERS] = {0};
+    uint8_t rec[UTL_MPSC_RECORD_SIZE];
+    uint64_t start;
+    uint8_t tag;
+    size_t len;
+    uint32_t seq;
+
+    // sem utl_mpsc_wait_set a espera não bloqueia
+    assert(utl_mpsc_get_wait(&q, &tag, rec, &len, UTL_CBF_WAIT_FOREVER) == UTL_CBF_ERROR);
+    utl_mpsc_wait_set(&q, true);
+
+    // vazio: o consumidor dorme até o timeout
+    start = time_ms();
+    assert(utl_mpsc_get_wait(&q, &tag, rec, &len, TEST_CBF_WAIT_TIMEOUT_MS) == UTL_CBF_TMROUT);
+    assert(time_ms() - start >= TEST_CBF_WAIT_TIMEOUT_MS);
+
+    // o consumidor já dorme quando o produtor publica, e é acordado por ele
+    pthread_create(&producers[0], NULL, mpsc_late_producer_thread, NULL);
+    assert(utl_mpsc_get_wait(&q, &tag, rec, &len, UTL_CBF_WAIT_FOREVER) == UTL_CBF_OK);
+    assert(tag == TEST_MPSC_NUM_PRODUCERS && len == 1 && rec[0] == 0xA5);
+    pthread_join(producers[0], NULL);
+
+    for(uintptr_t n = 0; n < TEST_MPSC_NUM_PRODUCERS; n++)
+        pthread_create(&producers[n], NULL, mpsc_producer_thread, (void*) n);
+
+    // mesma verificação de test_mpsc, mas o consumidor só espera na fila, sem polling
+    for(uint32_t total = 0; total < TEST_MPSC_NUM_PRODUCERS * TEST_MPSC_NUM_RECORDS; total++)
+    {
+        assert(utl_mpsc_get_wait(&q, &tag, rec, &len, UTL_CBF_WAIT_FOREVER) == UTL_CBF_OK);
+        assert(tag < TEST_MPSC_NUM_PRODUCERS);
+        memcpy(&seq, rec, sizeof(seq));
+        assert(seq == next[tag]);
+        assert(len == sizeof(seq) + (seq % (UTL_MPSC_RECORD_SIZE - sizeof(seq) + 1)));
+        next[tag]++;
+    }
+
+    for(size_t n = 0; n < TEST_MPSC_NUM_PRODUCERS; n++)
+        pthread_join(producers[n], NULL);
+
+    assert(utl_mpsc_records_available(&q) == 0);
+    utl_mpsc_wait_set(&q, false);
+
+    printf("MPSC wait test passed!\n");
+}
+
+int main(void)
+{
+    test_single_thread();
+    test_bulk();
+    test_zero_copy();
+    test_large();
+    test_mirror();
+    test_overwrite_stats();
+    test_overwrite_spsc();
+    test_spsc();
+    test_wait();
+    test_mpsc();
+    test_mpsc_wait();
+    test_rec();
+    test_rec_spsc();
+    test_ring_typed();
+
+    return 0;
+}
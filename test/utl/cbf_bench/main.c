@@ -0,0 +1,449 @@
+// pthread_setaffinity_np() quando compilado com -std=c11
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utl_cbf.h"
+
+// Benchmark de vazão e latência do utl_cbf entre duas threads (produtor e consumidor), opcionalmente fixadas
+// em núcleos escolhidos. Cada resultado é impresso como um objeto JSON por linha, para comparação automática.
+// Como referência, os mesmos testes rodam sobre uma fila circular protegida por pthread_mutex (campo "queue").
+
+#define BENCH_DEFAULT_BYTES (32u * 1024u * 1024u)
+#define BENCH_DEFAULT_LAT_SAMPLES 100000u
+#define BENCH_SPINS_BEFORE_YIELD 4096u
+
+typedef enum bench_mode_e
+{
+    BENCH_MODE_BYTE = 0, // utl_cbf_put / utl_cbf_get
+    BENCH_MODE_BULK,     // utl_cbf_write / utl_cbf_read em blocos de chunk bytes
+    BENCH_MODE_LATENCY,  // um carimbo de tempo por vez, com o buffer vazio (ping)
+} bench_mode_t;
+
+typedef enum bench_queue_e
+{
+    BENCH_QUEUE_CBF = 0, // utl_cbf, sem travas
+    BENCH_QUEUE_MUTEX,   // fila circular convencional, cada operação sob um pthread_mutex
+    BENCH_QUEUE_NUM,
+} bench_queue_t;
+
+static const char* bench_queue_names[BENCH_QUEUE_NUM] = {"cbf", "mutex"};
+
+// fila de referência: mesma semântica de utl_cbf (tamanho potência de 2, contadores livres), mas travada
+typedef struct bench_mq_s
+{
+    pthread_mutex_t lock;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t size;
+    uint32_t mask;
+    uint8_t* buffer;
+} bench_mq_t;
+
+typedef struct bench_ctx_s
+{
+    utl_cbf_t cb;
+    bench_mq_t mq;
+    bench_queue_t queue;
+    bench_mode_t mode;
+    uint64_t bytes;
+    size_t chunk;
+    uint64_t* lat;
+    uint32_t lat_samples;
+    uint64_t prod_ops;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    _Atomic uint32_t ready;
+} bench_ctx_t;
+
+static const uint32_t bench_sizes[] = {64, 1024, 16 * 1024, 256 * 1024, 4 * 1024 * 1024};
+static const size_t bench_chunks[] = {16, 256, 4096};
+
+static int bench_prod_core = -1;
+static int bench_cons_core = -1;
+// com um único núcleo disponível, girar só atrasa o outro lado
+static uint32_t bench_spins_before_yield = BENCH_SPINS_BEFORE_YIELD;
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static inline void bench_relax(uint32_t* spins)
+{
+    if(++(*spins) % bench_spins_before_yield == 0)
+        sched_yield();
+#if defined(__x86_64__) || defined(__i386__)
+    else
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    else
+        __asm__ volatile("yield");
+#endif
+}
+
+static void bench_mq_init(bench_mq_t* mq, uint8_t* area, uint32_t size)
+{
+    pthread_mutex_init(&mq->lock, NULL);
+    mq->head = mq->tail = 0;
+    mq->size = size;
+    mq->mask = size - 1;
+    mq->buffer = area;
+}
+
+static bool bench_mq_put(bench_mq_t* mq, uint8_t c)
+{
+    bool ok;
+
+    pthread_mutex_lock(&mq->lock);
+    ok = mq->head - mq->tail < mq->size;
+    if(ok)
+        mq->buffer[mq->head++ & mq->mask] = c;
+    pthread_mutex_unlock(&mq->lock);
+
+    return ok;
+}
+
+static bool bench_mq_get(bench_mq_t* mq, uint8_t* c)
+{
+    bool ok;
+
+    pthread_mutex_lock(&mq->lock);
+    ok = mq->head != mq->tail;
+    if(ok)
+        *c = mq->buffer[mq->tail++ & mq->mask];
+    pthread_mutex_unlock(&mq->lock);
+
+    return ok;
+}
+
+static size_t bench_mq_write(bench_mq_t* mq, const uint8_t* src, size_t n)
+{
+    pthread_mutex_lock(&mq->lock);
+    uint32_t free = mq->size - (mq->head - mq->tail);
+    uint32_t pos = mq->head & mq->mask;
+    n = n < free ? n : free;
+    size_t first = n < mq->size - pos ? n : mq->size - pos;
+    memcpy(&mq->buffer[pos], src, first);
+    memcpy(mq->buffer, src + first, n - first);
+    mq->head += (uint32_t) n;
+    pthread_mutex_unlock(&mq->lock);
+
+    return n;
+}
+
+static size_t bench_mq_read(bench_mq_t* mq, uint8_t* dst, size_t n)
+{
+    pthread_mutex_lock(&mq->lock);
+    uint32_t used = mq->head - mq->tail;
+    uint32_t pos = mq->tail & mq->mask;
+    n = n < used ? n : used;
+    size_t first = n < mq->size - pos ? n : mq->size - pos;
+    memcpy(dst, &mq->buffer[pos], first);
+    memcpy(dst + first, mq->buffer, n - first);
+    mq->tail += (uint32_t) n;
+    pthread_mutex_unlock(&mq->lock);
+
+    return n;
+}
+
+static uint32_t bench_mq_available(bench_mq_t* mq)
+{
+    pthread_mutex_lock(&mq->lock);
+    uint32_t used = mq->head - mq->tail;
+    pthread_mutex_unlock(&mq->lock);
+
+    return used;
+}
+
+// seleção da fila: o desvio é sempre o mesmo durante uma execução e não pesa na medida
+static inline bool bench_put(bench_ctx_t* ctx, uint8_t c)
+{
+    return ctx->queue == BENCH_QUEUE_MUTEX ? bench_mq_put(&ctx->mq, c) : utl_cbf_put(&ctx->cb, c) == UTL_CBF_OK;
+}
+
+static inline bool bench_get(bench_ctx_t* ctx, uint8_t* c)
+{
+    return ctx->queue == BENCH_QUEUE_MUTEX ? bench_mq_get(&ctx->mq, c) : utl_cbf_get(&ctx->cb, c) == UTL_CBF_OK;
+}
+
+static inline size_t bench_write(bench_ctx_t* ctx, const uint8_t* src, size_t n)
+{
+    return ctx->queue == BENCH_QUEUE_MUTEX ? bench_mq_write(&ctx->mq, src, n) : utl_cbf_write(&ctx->cb, src, n);
+}
+
+static inline size_t bench_read(bench_ctx_t* ctx, uint8_t* dst, size_t n)
+{
+    return ctx->queue == BENCH_QUEUE_MUTEX ? bench_mq_read(&ctx->mq, dst, n) : utl_cbf_read(&ctx->cb, dst, n);
+}
+
+static inline uint32_t bench_available(bench_ctx_t* ctx)
+{
+    return ctx->queue == BENCH_QUEUE_MUTEX ? bench_mq_available(&ctx->mq) : utl_cbf_bytes_available(&ctx->cb);
+}
+
+static void bench_pin(int core)
+{
+#if defined(__linux__)
+    if(core >= 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            fprintf(stderr, "could not pin thread to core %d\n", core);
+    }
+#else
+    (void) core;
+#endif
+}
+
+// as duas threads partem juntas, depois de fixadas nos seus núcleos
+static void bench_sync_start(bench_ctx_t* ctx)
+{
+    uint32_t spins = 0;
+
+    atomic_fetch_add(&ctx->ready, 1);
+    while(atomic_load(&ctx->ready) < 2)
+        bench_relax(&spins);
+}
+
+static void* bench_producer(void* arg)
+{
+    bench_ctx_t* ctx = arg;
+    uint8_t chunk[4096];
+    uint64_t ops = 0;
+    uint32_t spins = 0;
+
+    memset(chunk, 0x5A, sizeof(chunk));
+    bench_pin(bench_prod_core);
+    bench_sync_start(ctx);
+
+    switch(ctx->mode)
+    {
+    case BENCH_MODE_BYTE:
+        for(uint64_t n = 0; n < ctx->bytes;)
+        {
+            if(bench_put(ctx, (uint8_t) n))
+                n++, ops++;
+            else
+                bench_relax(&spins);
+        }
+        break;
+    case BENCH_MODE_BULK:
+        for(uint64_t n = 0; n < ctx->bytes;)
+        {
+            size_t len = ctx->bytes - n < ctx->chunk ? (size_t) (ctx->bytes - n) : ctx->chunk;
+            len = bench_write(ctx, chunk, len);
+            if(len)
+                n += len, ops++;
+            else
+                bench_relax(&spins);
+        }
+        break;
+    case BENCH_MODE_LATENCY:
+        for(uint32_t n = 0; n < ctx->lat_samples; n++)
+        {
+            while(bench_available(ctx))
+                bench_relax(&spins);
+            uint64_t now = bench_time_ns();
+            bench_write(ctx, (uint8_t*) &now, sizeof(now));
+            ops++;
+        }
+        break;
+    }
+
+    ctx->prod_ops = ops;
+
+    return NULL;
+}
+
+static void* bench_consumer(void* arg)
+{
+    bench_ctx_t* ctx = arg;
+    uint8_t chunk[4096];
+    uint32_t spins = 0;
+    uint8_t c;
+
+    bench_pin(bench_cons_core);
+    bench_sync_start(ctx);
+    ctx->start_ns = bench_time_ns();
+
+    switch(ctx->mode)
+    {
+    case BENCH_MODE_BYTE:
+        for(uint64_t n = 0; n < ctx->bytes;)
+        {
+            if(bench_get(ctx, &c))
+                n++;
+            else
+                bench_relax(&spins);
+        }
+        break;
+    case BENCH_MODE_BULK:
+        for(uint64_t n = 0; n < ctx->bytes;)
+        {
+            size_t len = bench_read(ctx, chunk, ctx->chunk);
+            if(len)
+                n += len;
+            else
+                bench_relax(&spins);
+        }
+        break;
+    case BENCH_MODE_LATENCY:
+        for(uint32_t n = 0; n < ctx->lat_samples; n++)
+        {
+            uint64_t sent;
+            while(bench_available(ctx) < sizeof(sent))
+                bench_relax(&spins);
+            bench_read(ctx, (uint8_t*) &sent, sizeof(sent));
+            ctx->lat[n] = bench_time_ns() - sent;
+        }
+        break;
+    }
+
+    ctx->end_ns = bench_time_ns();
+
+    return NULL;
+}
+
+static int bench_cmp_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+static bool bench_run(bench_ctx_t* ctx, uint32_t size)
+{
+    pthread_t prod, cons;
+    uint8_t* area = malloc(size);
+
+    if(!area || utl_cbf_init(&ctx->cb, area, size) != UTL_CBF_OK)
+    {
+        free(area);
+        return false;
+    }
+    bench_mq_init(&ctx->mq, area, size);
+
+    atomic_store(&ctx->ready, 0);
+    pthread_create(&cons, NULL, bench_consumer, ctx);
+    pthread_create(&prod, NULL, bench_producer, ctx);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+
+    pthread_mutex_destroy(&ctx->mq.lock);
+    free(area);
+
+    return true;
+}
+
+static void bench_throughput(bench_queue_t queue, bench_mode_t mode, uint32_t size, size_t chunk, uint64_t bytes)
+{
+    bench_ctx_t ctx = {.queue = queue, .mode = mode, .bytes = bytes, .chunk = chunk};
+
+    if(!bench_run(&ctx, size))
+        return;
+
+    uint64_t ns = ctx.end_ns - ctx.start_ns;
+    printf("{\"test\":\"%s\",\"queue\":\"%s\",\"size\":%" PRIu32 ",\"chunk\":%zu,\"bytes\":%" PRIu64
+           ",\"ns\":%" PRIu64 ",\"bytes_per_s\":%.0f,\"ns_per_op\":%.3f,\"ns_per_byte\":%.3f}\n",
+           mode == BENCH_MODE_BYTE ? "put_get" : "write_read", bench_queue_names[queue], size, chunk, bytes, ns,
+           (double) bytes * 1e9 / (double) ns, (double) ns / (double) ctx.prod_ops, (double) ns / (double) bytes);
+    fflush(stdout);
+}
+
+static void bench_latency(bench_queue_t queue, uint32_t size, uint32_t samples)
+{
+    bench_ctx_t ctx = {.queue = queue, .mode = BENCH_MODE_LATENCY, .lat_samples = samples};
+
+    ctx.lat = malloc(samples * sizeof(*ctx.lat));
+    if(!ctx.lat || !bench_run(&ctx, size))
+    {
+        free(ctx.lat);
+        return;
+    }
+
+    qsort(ctx.lat, samples, sizeof(*ctx.lat), bench_cmp_u64);
+    printf("{\"test\":\"latency\",\"queue\":\"%s\",\"size\":%" PRIu32 ",\"samples\":%" PRIu32
+           ",\"min_ns\":%" PRIu64 ",\"p50_ns\":%" PRIu64 ",\"p90_ns\":%" PRIu64 ",\"p99_ns\":%" PRIu64
+           ",\"p999_ns\":%" PRIu64 ",\"max_ns\":%" PRIu64 "}\n",
+           bench_queue_names[queue], size, samples, ctx.lat[0], ctx.lat[samples / 2],
+           ctx.lat[(uint64_t) samples * 90 / 100], ctx.lat[(uint64_t) samples * 99 / 100],
+           ctx.lat[(uint64_t) samples * 999 / 1000], ctx.lat[samples - 1]);
+    fflush(stdout);
+
+    free(ctx.lat);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t bytes = BENCH_DEFAULT_BYTES;
+    uint32_t samples = BENCH_DEFAULT_LAT_SAMPLES;
+    int opt;
+
+    while((opt = getopt(argc, argv, "p:c:n:l:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'p':
+            bench_prod_core = atoi(optarg);
+            break;
+        case 'c':
+            bench_cons_core = atoi(optarg);
+            break;
+        case 'n':
+            bytes = strtoull(optarg, NULL, 0);
+            break;
+        case 'l':
+            samples = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-p producer core] [-c consumer core] [-n bytes] [-l latency samples]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    if(bytes == 0 || samples == 0)
+    {
+        fprintf(stderr, "bytes and latency samples must be greater than zero\n");
+        return 1;
+    }
+
+    if(sysconf(_SC_NPROCESSORS_ONLN) < 2 || (bench_prod_core >= 0 && bench_prod_core == bench_cons_core))
+        bench_spins_before_yield = 1;
+
+    for(size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++)
+    {
+        uint32_t size = bench_sizes[s];
+
+        for(bench_queue_t q = 0; q < BENCH_QUEUE_NUM; q++)
+        {
+            bench_throughput(q, BENCH_MODE_BYTE, size, 1, bytes);
+            for(size_t c = 0; c < sizeof(bench_chunks) / sizeof(bench_chunks[0]); c++)
+            {
+                if(bench_chunks[c] <= size)
+                    bench_throughput(q, BENCH_MODE_BULK, size, bench_chunks[c], bytes);
+            }
+            bench_latency(q, size, samples);
+        }
+    }
+
+    return 0;
+}
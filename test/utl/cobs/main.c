@@ -0,0 +1,427 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <sys/uio.h>
+
+#include "hal_crc.h"
+#include "utl_cobs.h"
+#include "utl_crc16.h"
+
+#define TEST_COBS_MAX_LEN 1024
+#define TEST_COBS_NUM_FRAMES 2000
+
+// codificação usada nos quadros e no decodificador contínuo (app_zpe é compilado com UTL_COBS_ZPE_ENABLED)
+#if UTL_COBS_ZPE_ENABLED
+#define test_wire_encode cobs_zpe_encode
+#define TEST_WIRE_OVERHEAD_SIZE(len) COBS_ZPE_OVERHEAD_SIZE(len)
+#else
+#define test_wire_encode cobs_encode
+#define TEST_WIRE_OVERHEAD_SIZE(len) COBS_OVERHEAD_SIZE(len)
+#endif
+
+// gera dados com zeros frequentes e longas sequências sem zero (blocos de 254 bytes)
+static size_t test_frame_fill(uint8_t* data, size_t max_len)
+{
+    size_t len = (size_t) rand() % (max_len + 1);
+    int zeros = rand() % 4;
+
+    for(size_t n = 0; n < len; n++)
+        data[n] = zeros == 0 ? (uint8_t) (1 + rand() % 255) : (uint8_t) (rand() % (zeros * 4));
+
+    return len;
+}
+
+// implementações byte a byte de referência (o comportamento original de cobs_encode/cobs_decode)
+static size_t ref_encode(const uint8_t* input, uint8_t* output, size_t len)
+{
+    uint8_t* encode = output;
+    uint8_t* codep = encode++;
+    uint8_t code = 1;
+
+    for(const uint8_t* byte = input; len--; ++byte)
+    {
+        if(*byte)
+            *encode++ = *byte, ++code;
+
+        if(!*byte || code == 0xff)
+        {
+            *codep = code, code = 1, codep = encode;
+            if(!*byte || len)
+                ++encode;
+        }
+    }
+    *codep = code;
+
+    return (size_t) (encode - output);
+}
+
+static size_t ref_decode(const uint8_t* input, uint8_t* output, size_t len)
+{
+    const uint8_t* byte = input;
+    uint8_t* decode = output;
+
+    for(uint8_t code = 0xff, block = 0; byte < input + len; --block)
+    {
+        if(block)
+            *decode++ = *byte++;
+        else
+        {
+            if(code != 0xff)
+                *decode++ = 0;
+            block = code = *byte++;
+            if(!code)
+                break;
+        }
+    }
+
+    return (size_t) (decode - output);
+}
+
+static void test_bulk_identical(void)
+{
+    static uint8_t data[4 * TEST_COBS_MAX_LEN];
+    static uint8_t enc[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    static uint8_t ref[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    static uint8_t dec[sizeof(data) + 1];
+    static uint8_t rdec[sizeof(data) + 1];
+
+    // tamanhos ao redor dos limites de bloco (254) e do vetor (16/32), com e sem zeros
+    for(size_t len = 0; len <= sizeof(data); len += (len < 1100 ? 1 : 97))
+    {
+        for(int pattern = 0; pattern < 3; pattern++)
+        {
+            for(size_t n = 0; n < len; n++)
+                data[n] = pattern == 0 ? (uint8_t) (n % 255 + 1) : (uint8_t) (rand() % (pattern == 1 ? 256 : 3));
+
+            memset(enc, 0xAA, sizeof(enc));
+            memset(ref, 0xAA, sizeof(ref));
+            size_t elen = cobs_encode(data, enc, len);
+            assert(elen == ref_encode(data, ref, len));
+            assert(memcmp(enc, ref, sizeof(enc)) == 0);
+
+            // inclui um delimitador e lixo após o quadro
+            enc[elen] = 0;
+            memset(dec, 0x55, sizeof(dec));
+            memset(rdec, 0x55, sizeof(rdec));
+            size_t dlen = cobs_decode(enc, dec, elen + 1);
+            assert(dlen == ref_decode(enc, rdec, elen + 1));
+            assert(memcmp(dec, rdec, sizeof(dec)) == 0);
+            assert(cobs_decode(enc, dec, elen) == len && memcmp(dec, data, len) == 0);
+        }
+    }
+
+    printf("Bulk identical output test passed!\n");
+}
+
+static void test_bounded_inplace(void)
+{
+    uint8_t data[600];
+    uint8_t enc[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    uint8_t bounded[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    uint8_t buf[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+
+    for(size_t len = 0; len <= sizeof(data); len++)
+    {
+        for(size_t n = 0; n < len; n++)
+            data[n] = (len & 1) ? (uint8_t) (n % 255 + 1) : (uint8_t) (rand() % 4);
+
+        size_t elen = cobs_encode(data, enc, len);
+
+        // capacidade exata: mesma saída, sem escrever além dela
+        memset(bounded, 0xAA, sizeof(bounded));
+        assert(cobs_encode_bounded(data, bounded, len, elen) == elen);
+        assert(memcmp(bounded, enc, elen) == 0);
+        assert(bounded[elen] == 0xAA);
+
+        // um byte a menos: estouro, sem escrever além da capacidade
+        memset(bounded, 0xAA, sizeof(bounded));
+        assert(cobs_encode_bounded(data, bounded, len, elen - 1) == 0);
+        assert(bounded[elen - 1] == 0xAA);
+
+        // decodificação no próprio buffer, com delimitador
+        memcpy(buf, enc, elen);
+        buf[elen] = 0;
+        assert(cobs_decode_inplace(buf, elen) == len);
+        assert(memcmp(buf, data, len) == 0);
+    }
+
+    printf("Bounded and in-place test passed!\n");
+}
+
+static void test_encodev(void)
+{
+    static uint8_t data[2 * TEST_COBS_MAX_LEN];
+    static uint8_t enc[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    static uint8_t encv[COBS_OVERHEAD_SIZE(sizeof(data)) + 1];
+    utl_cobs_iovec_t iov[8];
+    struct iovec posix_iov[2];
+
+    // mesmo layout do struct iovec do POSIX
+    _Static_assert(sizeof(utl_cobs_iovec_t) == sizeof(struct iovec), "utl_cobs_iovec_t size");
+    _Static_assert(offsetof(utl_cobs_iovec_t, iov_base) == offsetof(struct iovec, iov_base), "iov_base");
+    _Static_assert(offsetof(utl_cobs_iovec_t, iov_len) == offsetof(struct iovec, iov_len), "iov_len");
+
+    assert(cobs_encodev(NULL, 0, encv) == 1 && encv[0] == 1);
+    posix_iov[0].iov_base = (void*) "\x11\x00";
+    posix_iov[0].iov_len = 2;
+    posix_iov[1].iov_base = (void*) "\x22";
+    posix_iov[1].iov_len = 1;
+    assert(cobs_encodev((const utl_cobs_iovec_t*) posix_iov, 2, encv) == 4);
+    assert(memcmp(encv, "\x02\x11\x02\x22", 4) == 0);
+
+    for(size_t frame = 0; frame < TEST_COBS_NUM_FRAMES; frame++)
+    {
+        size_t len = test_frame_fill(data, sizeof(data));
+        int iovcnt = 1 + rand() % 8;
+        size_t pos = 0;
+
+        // segmentos aleatórios, inclusive vazios, cobrindo todo o quadro
+        for(int seg = 0; seg < iovcnt; seg++)
+        {
+            size_t seg_len = seg == iovcnt - 1 ? len - pos : (size_t) rand() % (len - pos + 1);
+            iov[seg].iov_base = data + pos;
+            iov[seg].iov_len = seg_len;
+            pos += seg_len;
+        }
+
+        memset(enc, 0xAA, sizeof(enc));
+        memset(encv, 0xAA, sizeof(encv));
+        size_t elen = cobs_encode(data, enc, len);
+        assert(cobs_encodev(iov, iovcnt, encv) == elen);
+        assert(memcmp(enc, encv, sizeof(enc)) == 0);
+    }
+
+    printf("Scatter-gather encode test passed!\n");
+}
+
+static void test_frame(void)
+{
+    static uint8_t data[TEST_COBS_MAX_LEN + COBS_FRAME_CRC_SIZE];
+    static uint8_t frame[COBS_FRAME_SIZE(TEST_COBS_MAX_LEN)];
+    static uint8_t ref[COBS_FRAME_SIZE(TEST_COBS_MAX_LEN)];
+    static uint8_t dec[TEST_COBS_MAX_LEN + COBS_FRAME_CRC_SIZE];
+    size_t len;
+
+    for(size_t n = 0; n < TEST_COBS_NUM_FRAMES; n++)
+    {
+        size_t plen = test_frame_fill(data, TEST_COBS_MAX_LEN);
+
+        // mesmo resultado que CRC e COBS feitos em passos separados
+        uint16_t crc = utl_crc16_data(data, plen, 0xFFFF);
+        data[plen] = (uint8_t) (crc >> 8);
+        data[plen + 1] = (uint8_t) crc;
+        size_t rlen = test_wire_encode(data, ref, plen + COBS_FRAME_CRC_SIZE);
+        ref[rlen++] = 0;
+
+        size_t flen = cobs_frame_encode(data, frame, plen);
+        assert(flen == rlen && flen <= COBS_FRAME_SIZE(plen));
+        assert(memcmp(frame, ref, flen) == 0);
+
+        assert(cobs_frame_decode(frame, dec, flen, &len) && len == plen);
+        assert(memcmp(dec, data, plen) == 0);
+
+        // qualquer byte corrompido é detectado
+        size_t pos = (size_t) rand() % (flen - 1);
+        frame[pos] ^= (uint8_t) (1 + rand() % 255);
+        assert(!cobs_frame_decode(frame, dec, flen, &len) && len == 0);
+        frame[pos] = ref[pos];
+
+#if !UTL_COBS_ZPE_ENABLED
+        // decodificação no próprio buffer
+        assert(cobs_frame_decode(frame, frame, flen, &len) && len == plen);
+        assert(memcmp(frame, data, plen) == 0);
+#endif
+    }
+
+    // quadro curto demais para conter o CRC
+    const uint8_t empty[] = {0x01, 0x00};
+    assert(!cobs_frame_decode(empty, dec, sizeof(empty), &len));
+
+    printf("Frame test passed!\n");
+}
+
+static void test_encode_decode(void)
+{
+    uint8_t data[TEST_COBS_MAX_LEN];
+    uint8_t enc[COBS_OVERHEAD_SIZE(TEST_COBS_MAX_LEN)];
+    uint8_t dec[TEST_COBS_MAX_LEN];
+
+    for(size_t frame = 0; frame < TEST_COBS_NUM_FRAMES; frame++)
+    {
+        size_t len = test_frame_fill(data, TEST_COBS_MAX_LEN);
+        size_t elen = cobs_encode(data, enc, len);
+        assert(elen <= COBS_OVERHEAD_SIZE(len));
+        assert(memchr(enc, 0, elen) == NULL);
+        assert(cobs_decode(enc, dec, elen) == len);
+        assert(memcmp(data, dec, len) == 0);
+    }
+
+    printf("Encode/decode test passed!\n");
+}
+
+static void test_stream(void)
+{
+    static uint8_t stream[TEST_COBS_NUM_FRAMES * (TEST_WIRE_OVERHEAD_SIZE(TEST_COBS_MAX_LEN) + 1)];
+    static uint8_t frames[TEST_COBS_NUM_FRAMES][TEST_COBS_MAX_LEN];
+    static size_t lens[TEST_COBS_NUM_FRAMES];
+    uint8_t dec[TEST_COBS_MAX_LEN];
+    cobs_decoder_t decoder;
+    size_t slen = 0;
+    size_t frame = 0;
+
+    for(size_t n = 0; n < TEST_COBS_NUM_FRAMES; n++)
+    {
+        lens[n] = test_frame_fill(frames[n], TEST_COBS_MAX_LEN);
+        slen += test_wire_encode(frames[n], stream + slen, lens[n]);
+        stream[slen++] = 0;
+    }
+
+    // pedaços de tamanho aleatório, de 1 byte até vários quadros
+    cobs_decoder_init(&decoder, dec, sizeof(dec));
+    for(size_t pos = 0; pos < slen;)
+    {
+        size_t chunk = (size_t) rand() % 3000 + 1;
+        size_t used;
+
+        if(chunk > slen - pos)
+            chunk = slen - pos;
+
+        cobs_decoder_status_t status = cobs_decoder_feed(&decoder, stream + pos, chunk, &used);
+        assert(used <= chunk);
+        pos += used;
+        if(status == COBS_DECODER_FRAME)
+        {
+            assert(decoder.len == lens[frame]);
+            assert(memcmp(dec, frames[frame], lens[frame]) == 0);
+            frame++;
+        }
+        else
+        {
+            assert(status == COBS_DECODER_MORE && used == chunk);
+        }
+    }
+    assert(frame == TEST_COBS_NUM_FRAMES);
+
+    // byte a byte, como no callback de RX da UART
+    frame = 0;
+    cobs_decoder_reset(&decoder);
+    for(size_t pos = 0; pos < slen; pos++)
+    {
+        if(cobs_decoder_put(&decoder, stream[pos]) == COBS_DECODER_FRAME)
+        {
+            assert(decoder.len == lens[frame]);
+            assert(memcmp(dec, frames[frame], lens[frame]) == 0);
+            frame++;
+        }
+    }
+    assert(frame == TEST_COBS_NUM_FRAMES);
+
+    printf("Stream test passed!\n");
+}
+
+static void test_stream_errors(void)
+{
+    uint8_t data[64];
+    uint8_t enc[TEST_WIRE_OVERHEAD_SIZE(sizeof(data)) + 1];
+    uint8_t dec[16];
+    cobs_decoder_t decoder;
+    size_t elen;
+    size_t used;
+
+    memset(data, 0x11, sizeof(data));
+    cobs_decoder_init(&decoder, dec, sizeof(dec));
+
+    // quadro maior que a saída é descartado e o seguinte é recebido normalmente
+    elen = test_wire_encode(data, enc, sizeof(data));
+    enc[elen++] = 0;
+    assert(cobs_decoder_feed(&decoder, enc, elen, &used) == COBS_DECODER_ERROR && used == elen);
+    assert(decoder.len == 0);
+    elen = test_wire_encode(data, enc, sizeof(dec));
+    enc[elen++] = 0;
+    assert(cobs_decoder_feed(&decoder, enc, elen, &used) == COBS_DECODER_FRAME && used == elen);
+    assert(decoder.len == sizeof(dec) && memcmp(dec, data, sizeof(dec)) == 0);
+
+    // bloco truncado por um delimitador
+    const uint8_t truncated[] = {0x05, 0x11, 0x22, 0x00, 0x02, 0x33, 0x00};
+    assert(cobs_decoder_feed(&decoder, truncated, sizeof(truncated), &used) == COBS_DECODER_ERROR && used == 4);
+    assert(cobs_decoder_feed(&decoder, truncated + used, sizeof(truncated) - used, &used) == COBS_DECODER_FRAME);
+    assert(decoder.len == 1 && dec[0] == 0x33);
+
+    // delimitadores seguidos geram quadros vazios
+    assert(cobs_decoder_put(&decoder, 0) == COBS_DECODER_FRAME && decoder.len == 0);
+
+    printf("Stream error test passed!\n");
+}
+
+static void test_zpe_vector(const uint8_t* data, size_t len, const uint8_t* ref, size_t ref_len)
+{
+    uint8_t enc[16];
+    uint8_t dec[16];
+
+    assert(cobs_zpe_encode(data, enc, len) == ref_len && memcmp(enc, ref, ref_len) == 0);
+    assert(cobs_zpe_decode(enc, dec, ref_len) == len && memcmp(dec, data, len) == 0);
+}
+
+static void test_zpe(void)
+{
+    static uint8_t data[TEST_COBS_MAX_LEN];
+    static uint8_t enc[COBS_ZPE_OVERHEAD_SIZE(TEST_COBS_MAX_LEN) + 2];
+    static uint8_t dec[TEST_COBS_MAX_LEN + 1];
+
+    // vetores conhecidos: zero isolado, par de zeros, par no fim e o zero implícito
+    test_zpe_vector(NULL, 0, (const uint8_t[]){0x01}, 1);
+    test_zpe_vector((const uint8_t[]){0x00}, 1, (const uint8_t[]){0xE1}, 1);
+    test_zpe_vector((const uint8_t[]){0x00, 0x00}, 2, (const uint8_t[]){0xE1, 0x01}, 2);
+    test_zpe_vector((const uint8_t[]){0x11, 0x22, 0x00, 0x00, 0x33}, 5,
+                    (const uint8_t[]){0xE3, 0x11, 0x22, 0x02, 0x33}, 5);
+    test_zpe_vector((const uint8_t[]){0x11, 0x00, 0x22}, 3, (const uint8_t[]){0x02, 0x11, 0x02, 0x22}, 4);
+
+    // dados cheios de zeros ficam menores que a entrada
+    memset(data, 0, 32);
+    assert(cobs_zpe_encode(data, enc, 32) == 17);
+
+    for(size_t frame = 0; frame < TEST_COBS_NUM_FRAMES; frame++)
+    {
+        size_t len = test_frame_fill(data, TEST_COBS_MAX_LEN);
+
+        // blocos de 223 bytes e pares no fim do quadro
+        if(frame % 4 == 1)
+            memset(data, 0x5A, len);
+        else if(frame % 4 == 2 && len >= 3)
+            data[len - 1] = data[len - 2] = data[len - 3] = 0;
+
+        memset(enc, 0xAA, sizeof(enc));
+        size_t elen = cobs_zpe_encode(data, enc, len);
+        assert(elen <= COBS_ZPE_OVERHEAD_SIZE(len) && enc[elen] == 0xAA);
+        assert(memchr(enc, 0, elen) == NULL);
+        assert(cobs_zpe_decode(enc, dec, elen) == len && memcmp(dec, data, len) == 0);
+
+        // o delimitador encerra a decodificação
+        enc[elen] = 0;
+        enc[elen + 1] = 0x11;
+        assert(cobs_zpe_decode(enc, dec, elen + 2) == len && memcmp(dec, data, len) == 0);
+    }
+
+    printf("ZPE encode/decode test passed!\n");
+}
+
+int main(void)
+{
+    srand(1234);
+    hal_crc_init();
+
+    test_encode_decode();
+    test_bulk_identical();
+    test_bounded_inplace();
+    test_encodev();
+    test_frame();
+    test_stream();
+    test_stream_errors();
+    test_zpe();
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utl_cobs.h"
+
+// Benchmark de bytes no fio do COBS padrão x COBS/ZPE, para quadros de telemetria e outros conteúdos típicos.
+// Cada resultado é impresso como um objeto JSON por linha, para comparação automática.
+
+#define BENCH_DEFAULT_FRAMES 20000u
+#define BENCH_DEFAULT_BAUD 9600u
+#define BENCH_MAX_LEN 1024
+// bits por byte no fio com 8N1
+#define BENCH_BITS_PER_BYTE 10u
+
+typedef void (*bench_fill_t)(uint8_t* data, size_t len);
+
+typedef struct bench_dataset_s
+{
+    const char* name;
+    bench_fill_t fill;
+} bench_dataset_t;
+
+static const size_t bench_lens[] = {16, 32, 64, 128, 256, BENCH_MAX_LEN};
+
+static uint32_t bench_seed = 1;
+static uint32_t bench_tick;
+
+static uint32_t bench_rand(void)
+{
+    // xorshift32, reprodutível entre execuções
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 17;
+    bench_seed ^= bench_seed << 5;
+    return bench_seed;
+}
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static size_t bench_put_le(uint8_t* data, size_t pos, size_t len, uint32_t value, size_t size)
+{
+    for(size_t n = 0; n < size && pos < len; n++)
+        data[pos++] = (uint8_t) (value >> (8 * n));
+    return pos;
+}
+
+// amostras de sensores: campos largos com valores pequenos, flags quase sempre zeradas e posição GPS
+static void bench_fill_telemetry(uint8_t* data, size_t len)
+{
+    for(size_t pos = 0; pos < len;)
+    {
+        bench_tick += 10;
+        pos = bench_put_le(data, pos, len, bench_tick, 4);
+        for(int axis = 0; axis < 6; axis++)
+            pos = bench_put_le(data, pos, len, (uint32_t) (int32_t) (bench_rand() % 512 - 256), 2);
+        pos = bench_put_le(data, pos, len, 3600 + bench_rand() % 600, 2);
+        pos = bench_put_le(data, pos, len, bench_rand() % 16 == 0 ? 0x01 : 0x00, 1);
+        pos = bench_put_le(data, pos, len, 0, 3);
+        pos = bench_put_le(data, pos, len, (uint32_t) -235000000 + bench_rand() % 1000, 4);
+        pos = bench_put_le(data, pos, len, (uint32_t) -468000000 + bench_rand() % 1000, 4);
+    }
+}
+
+// contadores de 32 bits com valores baixos
+static void bench_fill_counters(uint8_t* data, size_t len)
+{
+    for(size_t pos = 0; pos < len;)
+        pos = bench_put_le(data, pos, len, bench_rand() % 1000, 4);
+}
+
+// texto sem zeros, pior caso relativo do ZPE (blocos de 223 em vez de 254)
+static void bench_fill_nmea(uint8_t* data, size_t len)
+{
+    static const char nmea[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+
+    for(size_t pos = 0; pos < len; pos++)
+        data[pos] = (uint8_t) nmea[pos % (sizeof(nmea) - 1)];
+}
+
+static void bench_fill_random(uint8_t* data, size_t len)
+{
+    for(size_t pos = 0; pos < len; pos++)
+        data[pos] = (uint8_t) bench_rand();
+}
+
+static void bench_fill_zeros(uint8_t* data, size_t len)
+{
+    memset(data, 0, len);
+}
+
+static const bench_dataset_t bench_datasets[] = {
+    {"telemetry", bench_fill_telemetry}, {"counters", bench_fill_counters}, {"nmea", bench_fill_nmea},
+    {"random", bench_fill_random},       {"zeros", bench_fill_zeros},
+};
+
+static void bench_run(const bench_dataset_t* set, size_t len, uint32_t frames, uint32_t baud)
+{
+    static uint8_t data[BENCH_MAX_LEN];
+    static uint8_t enc[COBS_ZPE_OVERHEAD_SIZE(BENCH_MAX_LEN) + COBS_OVERHEAD_SIZE(BENCH_MAX_LEN)];
+    uint64_t cobs_bytes = 0;
+    uint64_t zpe_bytes = 0;
+    uint64_t cobs_ns = 0;
+    uint64_t zpe_ns = 0;
+
+    for(uint32_t frame = 0; frame < frames; frame++)
+    {
+        uint64_t t0, t1, t2;
+
+        set->fill(data, len);
+
+        // delimitador incluso: é o que efetivamente ocupa a linha
+        t0 = bench_time_ns();
+        cobs_bytes += cobs_encode(data, enc, len) + 1;
+        t1 = bench_time_ns();
+        zpe_bytes += cobs_zpe_encode(data, enc, len) + 1;
+        t2 = bench_time_ns();
+
+        cobs_ns += t1 - t0;
+        zpe_ns += t2 - t1;
+    }
+
+    uint64_t raw = (uint64_t) len * frames;
+    printf("{\"data\":\"%s\",\"len\":%zu,\"frames\":%" PRIu32 ",\"cobs_bytes_per_frame\":%.2f"
+           ",\"zpe_bytes_per_frame\":%.2f,\"cobs_overhead_pct\":%.2f,\"zpe_overhead_pct\":%.2f"
+           ",\"cobs_ms_per_frame\":%.3f,\"zpe_ms_per_frame\":%.3f,\"baud\":%" PRIu32
+           ",\"cobs_encode_ns_per_byte\":%.3f,\"zpe_encode_ns_per_byte\":%.3f}\n",
+           set->name, len, frames, (double) cobs_bytes / frames, (double) zpe_bytes / frames,
+           100.0 * ((double) cobs_bytes - (double) raw) / (double) raw,
+           100.0 * ((double) zpe_bytes - (double) raw) / (double) raw,
+           1000.0 * (double) cobs_bytes * BENCH_BITS_PER_BYTE / baud / frames,
+           1000.0 * (double) zpe_bytes * BENCH_BITS_PER_BYTE / baud / frames, baud, (double) cobs_ns / (double) raw,
+           (double) zpe_ns / (double) raw);
+    fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+    uint32_t baud = BENCH_DEFAULT_BAUD;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:b:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'n':
+            frames = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            baud = (uint32_t) strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n frames per test] [-b baud rate]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(frames == 0 || baud == 0)
+    {
+        fprintf(stderr, "frames and baud rate must be greater than zero\n");
+        return 1;
+    }
+
+    for(size_t s = 0; s < sizeof(bench_datasets) / sizeof(bench_datasets[0]); s++)
+    {
+        for(size_t l = 0; l < sizeof(bench_lens) / sizeof(bench_lens[0]); l++)
+            bench_run(&bench_datasets[s], bench_lens[l], frames, baud);
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "utl_crc.h"
+#include "utl_crc16.h"
+
+#define TEST_CRC_MAX_LEN 2048
+#define TEST_CRC_NUM_BUFFERS 500
+
+typedef struct test_variant_s
+{
+    const char* name;
+    const utl_crc_spec_t* spec;
+    uint8_t width;
+    uint32_t poly;
+    uint32_t init;
+    bool reflected;
+    uint32_t xorout;
+} test_variant_t;
+
+#define TEST_VARIANT(name, width, poly, init, reflected, xorout) \
+    {#name, &utl_##name##_spec, width, poly, init, reflected, xorout},
+
+// parâmetros lidos da mesma lista usada pelo utl_crc.c, mas calculados bit a bit pela referência
+static const test_variant_t variants[] = {UTL_CRC_VARIANTS(TEST_VARIANT)};
+
+#define TEST_NUM_VARIANTS (sizeof(variants) / sizeof(variants[0]))
+
+static uint32_t ref_reflect(uint32_t value, uint8_t bits)
+{
+    uint32_t out = 0;
+
+    for(uint8_t n = 0; n < bits; n++)
+        out |= ((value >> n) & 1u) << (bits - 1 - n);
+
+    return out;
+}
+
+// implementação bit a bit de referência, no modelo dos catálogos de CRC (poly, init, refin = refout, xorout)
+static uint32_t ref_crc(const test_variant_t* v, const uint8_t* data, size_t len)
+{
+    uint32_t top = UINT32_C(1) << (v->width - 1);
+    uint32_t mask = top | (top - 1);
+    uint32_t crc = v->init;
+
+    while(len--)
+    {
+        uint8_t byte = *data++;
+
+        if(v->reflected)
+            byte = (uint8_t) ref_reflect(byte, 8);
+        crc ^= (uint32_t) byte << (v->width - 8);
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc & top) ? (crc << 1) ^ v->poly : crc << 1;
+        crc &= mask;
+    }
+
+    if(v->reflected)
+        crc = ref_reflect(crc, v->width);
+
+    return crc ^ v->xorout;
+}
+
+static const test_variant_t* test_variant_find(const char* name)
+{
+    for(size_t n = 0; n < TEST_NUM_VARIANTS; n++)
+    {
+        if(strcmp(variants[n].name, name) == 0)
+            return &variants[n];
+    }
+
+    return NULL;
+}
+
+static void test_vectors(void)
+{
+    // valores de verificação dos catálogos, para "123456789"
+    static const struct
+    {
+        const char* name;
+        uint32_t check;
+    } checks[] = {
+        {"crc8", 0xF4}, {"crc16_ccitt", 0x29B1}, {"crc16_modbus", 0x4B37}, {"crc24q", 0xCDE703},
+        {"crc32", 0xCBF43926}, {"crc32c", 0xE3069283},
+    };
+    const uint8_t check[] = "123456789";
+
+    for(size_t n = 0; n < sizeof(checks) / sizeof(checks[0]); n++)
+    {
+        const test_variant_t* v = test_variant_find(checks[n].name);
+        if(!v)
+            continue;
+
+        assert(ref_crc(v, check, sizeof(check) - 1) == checks[n].check);
+        assert(utl_crc_data(v->spec, check, sizeof(check) - 1) == checks[n].check);
+        assert(utl_crc_data(v->spec, check, 0) == (v->init ^ v->xorout));
+    }
+
+    // mesmo CRC do utl_crc16
+    assert(utl_crc_data(&utl_crc16_ccitt_spec, check, sizeof(check) - 1) == utl_crc16(check, sizeof(check) - 1));
+
+    printf("CRC vector test passed!\n");
+}
+
+static void test_tables(void)
+{
+    // cada entrada de cada tabela gerada pelo compilador confere com o cálculo bit a bit
+    for(size_t n = 0; n < TEST_NUM_VARIANTS; n++)
+    {
+        const test_variant_t* v = &variants[n];
+        test_variant_t raw = *v;
+        uint8_t data[UTL_CRC_SLICES] = {0};
+
+        // registrador zerado e sem xorout: o CRC de [b, 0, ... 0] é a própria entrada
+        raw.init = 0;
+        raw.xorout = 0;
+        for(size_t k = 0; k < UTL_CRC_SLICES; k++)
+        {
+            for(uint32_t b = 0; b < 256; b++)
+            {
+                data[0] = (uint8_t) b;
+                uint32_t entry = v->reflected ? v->spec->table[k][b] : v->spec->table[k][b] >> v->spec->shift;
+                assert(entry == ref_crc(&raw, data, k + 1));
+            }
+        }
+    }
+
+    printf("CRC table test passed!\n");
+}
+
+static void test_random(void)
+{
+    static uint8_t data[TEST_CRC_MAX_LEN + 8];
+
+    for(size_t n = 0; n < TEST_CRC_NUM_BUFFERS; n++)
+    {
+        // inícios desalinhados e tamanhos que deixam sobras de 1 a 7 bytes
+        size_t off = (size_t) rand() % 8;
+        size_t len = (size_t) rand() % (TEST_CRC_MAX_LEN + 1);
+
+        for(size_t pos = 0; pos < len; pos++)
+            data[off + pos] = (uint8_t) rand();
+
+        for(size_t m = 0; m < TEST_NUM_VARIANTS; m++)
+        {
+            const test_variant_t* v = &variants[m];
+            uint32_t crc = ref_crc(v, data + off, len);
+
+            assert(utl_crc_data(v->spec, data + off, len) == crc);
+
+            // em pedaços, com o registrador passado adiante
+            size_t cut = len ? (size_t) rand() % len : 0;
+            uint32_t reg = utl_crc_init(v->spec);
+            reg = utl_crc_update(v->spec, reg, data + off, cut);
+            reg = utl_crc_update(v->spec, reg, data + off + cut, len - cut);
+            assert(utl_crc_final(v->spec, reg) == crc);
+        }
+    }
+
+    printf("CRC random buffer test passed! (%d bytes per step, %zu variants)\n", UTL_CRC_SLICES, TEST_NUM_VARIANTS);
+}
+
+int main(void)
+{
+    test_vectors();
+    test_tables();
+    test_random();
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "utl_crc16.h"
+
+#define TEST_CRC16_MAX_LEN 4096
+#define TEST_CRC16_NUM_BUFFERS 2000
+
+// implementação bit a bit de referência (CRC-16/CCITT, polinômio 0x1021, MSB primeiro)
+static uint16_t ref_crc16(const uint8_t* data, size_t len, uint16_t crc)
+{
+    while(len--)
+    {
+        crc ^= (uint16_t) (*data++ << 8);
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+    }
+
+    return crc;
+}
+
+static void test_vectors(void)
+{
+    const uint8_t check[] = "123456789";
+
+    // CRC-16/CCITT-FALSE
+    assert(utl_crc16(check, sizeof(check) - 1) == 0x29B1);
+    assert(utl_crc16_data(check, 0, 0xFFFF) == 0xFFFF);
+    assert(utl_crc16_data(check, sizeof(check) - 1, 0) == 0x31C3);
+
+    printf("CRC16 vector test passed!\n");
+}
+
+static void test_random(void)
+{
+    static uint8_t data[TEST_CRC16_MAX_LEN];
+
+    for(size_t n = 0; n < TEST_CRC16_NUM_BUFFERS; n++)
+    {
+        // inícios desalinhados e tamanhos que deixam sobras de 1 a 7 bytes
+        size_t off = (size_t) rand() % 8;
+        size_t len = (size_t) rand() % (TEST_CRC16_MAX_LEN - off + 1);
+        uint16_t acc = (uint16_t) rand();
+
+        for(size_t pos = 0; pos < len; pos++)
+            data[off + pos] = (uint8_t) rand();
+
+        assert(utl_crc16_data(data + off, len, acc) == ref_crc16(data + off, len, acc));
+
+        // em pedaços, com o acumulador passado adiante
+        size_t cut = len ? (size_t) rand() % len : 0;
+        uint16_t crc = utl_crc16_data(data + off, cut, acc);
+        assert(utl_crc16_data(data + off + cut, len - cut, crc) == ref_crc16(data + off, len, acc));
+    }
+
+    printf("CRC16 random buffer test passed! (%d bytes per step, clmul %d)\n", UTL_CRC16_SLICES,
+           UTL_CRC16_CLMUL_ENABLED);
+}
+
+static void test_lengths(void)
+{
+    static uint8_t data[1024 + 64];
+
+    for(size_t pos = 0; pos < sizeof(data); pos++)
+        data[pos] = (uint8_t) rand();
+
+    // todos os tamanhos em torno do limite da dobra (blocos de 64 e 16 bytes e o restante)
+    for(size_t len = 0; len <= 1024; len++)
+    {
+        uint16_t acc = (uint16_t) rand();
+        assert(utl_crc16_data(data + len % 64, len, acc) == ref_crc16(data + len % 64, len, acc));
+    }
+
+    printf("CRC16 length test passed!\n");
+}
+
+static void test_combine(void)
+{
+    static uint8_t data[TEST_CRC16_MAX_LEN];
+
+    for(size_t pos = 0; pos < sizeof(data); pos++)
+        data[pos] = (uint8_t) rand();
+
+    for(size_t n = 0; n < TEST_CRC16_NUM_BUFFERS; n++)
+    {
+        size_t len = (size_t) rand() % (sizeof(data) + 1);
+        size_t cut = (size_t) rand() % (len + 1);
+        uint16_t acc = (uint16_t) rand();
+
+        uint16_t crc_a = utl_crc16_data(data, cut, acc);
+        uint16_t crc_b = utl_crc16(data + cut, len - cut);
+        assert(utl_crc16_combine(crc_a, crc_b, len - cut) == utl_crc16_data(data, len, acc));
+    }
+
+    printf("CRC16 combine test passed!\n");
+}
+
+static void test_mt(void)
+{
+    const size_t len = 8 * UTL_CRC16_MT_MIN_CHUNK + 12345;
+    uint8_t* data = malloc(len);
+
+    assert(data);
+    for(size_t pos = 0; pos < len; pos++)
+        data[pos] = (uint8_t) rand();
+
+    // de uma thread (buffer pequeno demais para dividir) até mais threads que fatias
+    for(unsigned threads = 0; threads <= 12; threads++)
+    {
+        size_t part = threads * UTL_CRC16_MT_MIN_CHUNK / 2 + 7;
+        uint16_t acc = (uint16_t) rand();
+
+        assert(utl_crc16_data_mt(data, len, acc, threads) == utl_crc16_data(data, len, acc));
+        assert(utl_crc16_data_mt(data, part, acc, threads) == utl_crc16_data(data, part, acc));
+    }
+
+    free(data);
+
+    printf("CRC16 multi-thread test passed!\n");
+}
+
+int main(void)
+{
+    srand(1234);
+
+    test_vectors();
+    test_random();
+    test_lengths();
+    test_combine();
+    test_mt();
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utl_crc16.h"
+
+// Benchmark de vazão do utl_crc16_data em buffers de 64 bytes a 16 MiB. app usa a dobra com PCLMULQDQ quando
+// a CPU suporta, app_table só as tabelas. Buffers grandes também são medidos com utl_crc16_data_mt (-t threads,
+// 0: uma por CPU). Cada resultado é impresso como um objeto JSON por linha.
+
+#define BENCH_DEFAULT_BYTES (1024u * 1024u * 1024u)
+#define BENCH_MAX_SIZE (16u * 1024u * 1024u)
+
+static const size_t bench_sizes[] = {64, 256, 1024, 4096, 64 * 1024, 1024 * 1024, BENCH_MAX_SIZE};
+
+typedef uint16_t (*bench_crc_t)(const uint8_t* data, size_t len, uint16_t acc);
+
+static unsigned bench_threads = 0;
+
+static uint16_t bench_crc_mt(const uint8_t* data, size_t len, uint16_t acc)
+{
+    return utl_crc16_data_mt(data, len, acc, bench_threads);
+}
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static const char* bench_impl(void)
+{
+#if UTL_CRC16_CLMUL_ENABLED
+    if(__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+        return "clmul";
+#endif
+    return "table";
+}
+
+static void bench_run(const uint8_t* data, size_t size, uint64_t bytes, bench_crc_t crc_fn, const char* suffix)
+{
+    uint64_t rounds = bytes / size ? bytes / size : 1;
+    uint16_t crc = 0xFFFF;
+
+    // aquece caches e o seletor de frequência
+    crc = crc_fn(data, size, crc);
+
+    uint64_t start = bench_time_ns();
+    for(uint64_t r = 0; r < rounds; r++)
+        crc = crc_fn(data, size, crc);
+    uint64_t ns = bench_time_ns() - start;
+
+    printf("{\"test\":\"crc16\",\"impl\":\"%s%s\",\"size\":%zu,\"rounds\":%" PRIu64 ",\"ns\":%" PRIu64
+           ",\"gb_per_s\":%.3f,\"ns_per_byte\":%.4f,\"crc\":%u}\n",
+           bench_impl(), suffix, size, rounds, ns, (double) size * (double) rounds / (double) ns,
+           (double) ns / ((double) size * (double) rounds), crc);
+    fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t bytes = BENCH_DEFAULT_BYTES;
+    uint8_t* data;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:t:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'n':
+            bytes = strtoull(optarg, NULL, 0);
+            break;
+        case 't':
+            bench_threads = (unsigned) strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n bytes per test] [-t threads]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(bytes == 0)
+    {
+        fprintf(stderr, "bytes must be greater than zero\n");
+        return 1;
+    }
+
+    data = malloc(BENCH_MAX_SIZE);
+    if(!data)
+        return 1;
+    for(size_t pos = 0; pos < BENCH_MAX_SIZE; pos++)
+        data[pos] = (uint8_t) (pos * 131 + (pos >> 9));
+
+    for(size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++)
+    {
+        bench_run(data, bench_sizes[s], bytes, utl_crc16_data, "");
+        if(bench_sizes[s] >= 2 * UTL_CRC16_MT_MIN_CHUNK)
+            bench_run(data, bench_sizes[s], bytes, bench_crc_mt, "_mt");
+    }
+
+    free(data);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "utl_crc32c.h"
+
+#define TEST_CRC32C_MAX_LEN (32 * 1024)
+#define TEST_CRC32C_NUM_BUFFERS 300
+
+// implementação bit a bit de referência (CRC-32C, polinômio 0x82F63B78 refletido)
+static uint32_t ref_crc32c(const uint8_t* data, size_t len, uint32_t acc)
+{
+    uint32_t crc = ~acc;
+
+    while(len--)
+    {
+        crc ^= *data++;
+        for(int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+    }
+
+    return ~crc;
+}
+
+static const char* test_impl(void)
+{
+#if UTL_CRC32C_SSE42_ENABLED
+    if(__builtin_cpu_supports("sse4.2"))
+        return __builtin_cpu_supports("pclmul") ? "sse4.2 + pclmul" : "sse4.2";
+#endif
+    return "table";
+}
+
+static void test_vectors(void)
+{
+    const uint8_t check[] = "123456789";
+    uint8_t data[32];
+
+    assert(utl_crc32c(check, sizeof(check) - 1) == 0xE3069283);
+    assert(utl_crc32c(check, 0) == 0);
+
+    // RFC 3720, B.4
+    memset(data, 0x00, sizeof(data));
+    assert(utl_crc32c(data, sizeof(data)) == 0x8A9136AA);
+    memset(data, 0xFF, sizeof(data));
+    assert(utl_crc32c(data, sizeof(data)) == 0x62A8AB43);
+    for(size_t n = 0; n < sizeof(data); n++)
+        data[n] = (uint8_t) n;
+    assert(utl_crc32c(data, sizeof(data)) == 0x46DD794E);
+    for(size_t n = 0; n < sizeof(data); n++)
+        data[n] = (uint8_t) (31 - n);
+    assert(utl_crc32c(data, sizeof(data)) == 0x113FDB5C);
+
+    printf("CRC32C vector test passed!\n");
+}
+
+static void test_random(void)
+{
+    static uint8_t data[TEST_CRC32C_MAX_LEN + 8];
+
+    for(size_t n = 0; n < TEST_CRC32C_NUM_BUFFERS; n++)
+    {
+        // inícios desalinhados e tamanhos que deixam sobras de 1 a 7 bytes
+        size_t off = (size_t) rand() % 8;
+        size_t len = (size_t) rand() % (TEST_CRC32C_MAX_LEN + 1);
+        uint32_t acc = (uint32_t) rand();
+
+        for(size_t pos = 0; pos < len; pos++)
+            data[off + pos] = (uint8_t) rand();
+
+        assert(utl_crc32c_data(data + off, len, acc) == ref_crc32c(data + off, len, acc));
+
+        // em pedaços, com o resultado anterior passado adiante
+        size_t cut = len ? (size_t) rand() % len : 0;
+        uint32_t crc = utl_crc32c_data(data + off, cut, 0);
+        assert(utl_crc32c_data(data + off + cut, len - cut, crc) == ref_crc32c(data + off, len, 0));
+    }
+
+    printf("CRC32C random buffer test passed! (%s)\n", test_impl());
+}
+
+static void test_lengths(void)
+{
+    static uint8_t data[3 * 2048 * 2 + 64];
+
+    for(size_t pos = 0; pos < sizeof(data); pos++)
+        data[pos] = (uint8_t) rand();
+
+    // em torno dos blocos das três faixas intercaladas (3 x 256 e 3 x 2048 bytes)
+    for(size_t len = 0; len <= sizeof(data) - 64; len += (len < 1024 || len % 768 > 760) ? 1 : 7)
+    {
+        uint32_t acc = (uint32_t) rand();
+        assert(utl_crc32c_data(data + len % 64, len, acc) == ref_crc32c(data + len % 64, len, acc));
+    }
+
+    printf("CRC32C length test passed!\n");
+}
+
+int main(void)
+{
+    test_vectors();
+    test_random();
+    test_lengths();
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "utl_crc16.h"
+#include "utl_crc32c.h"
+
+// Benchmark de vazão do utl_crc32c_data x utl_crc16_data em buffers de 64 bytes a 16 MiB, em bytes por ciclo.
+// app usa as instruções da CPU quando disponíveis, app_table só as tabelas nos dois. Os ciclos são os do TSC
+// (frequência nominal, não a do núcleo) e, fora de x86, ficam zerados. Cada resultado é impresso como um
+// objeto JSON por linha.
+
+#define BENCH_DEFAULT_BYTES (1024u * 1024u * 1024u)
+#define BENCH_MAX_SIZE (16u * 1024u * 1024u)
+
+static const size_t bench_sizes[] = {64, 256, 1024, 4096, 64 * 1024, 1024 * 1024, BENCH_MAX_SIZE};
+
+typedef uint32_t (*bench_crc_t)(const uint8_t* data, size_t len, uint32_t acc);
+
+static uint32_t bench_crc16(const uint8_t* data, size_t len, uint32_t acc)
+{
+    return utl_crc16_data(data, len, (uint16_t) acc);
+}
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static const char* bench_impl_crc32c(void)
+{
+#if UTL_CRC32C_SSE42_ENABLED
+    if(__builtin_cpu_supports("sse4.2"))
+        return __builtin_cpu_supports("pclmul") ? "sse42_3way" : "sse42";
+#endif
+    return "table";
+}
+
+static const char* bench_impl_crc16(void)
+{
+#if UTL_CRC16_CLMUL_ENABLED
+    if(__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+        return "clmul";
+#endif
+    return "table";
+}
+
+static void bench_run(const uint8_t* data, size_t size, uint64_t bytes, const char* test, const char* impl,
+                      bench_crc_t crc_fn)
+{
+    uint64_t rounds = bytes / size ? bytes / size : 1;
+    uint32_t crc = 0;
+
+    // aquece caches e o seletor de frequência
+    crc = crc_fn(data, size, crc);
+
+    uint64_t start = bench_time_ns();
+    uint64_t start_cycles = bench_cycles();
+    for(uint64_t r = 0; r < rounds; r++)
+        crc = crc_fn(data, size, crc);
+    uint64_t cycles = bench_cycles() - start_cycles;
+    uint64_t ns = bench_time_ns() - start;
+    double total = (double) size * (double) rounds;
+
+    printf("{\"test\":\"%s\",\"impl\":\"%s\",\"size\":%zu,\"rounds\":%" PRIu64 ",\"ns\":%" PRIu64
+           ",\"cycles\":%" PRIu64 ",\"bytes_per_cycle\":%.3f,\"gb_per_s\":%.3f,\"crc\":%" PRIu32 "}\n",
+           test, impl, size, rounds, ns, cycles, cycles ? total / (double) cycles : 0.0, total / (double) ns, crc);
+    fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t bytes = BENCH_DEFAULT_BYTES;
+    uint8_t* data;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'n':
+            bytes = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n bytes per test]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(bytes == 0)
+    {
+        fprintf(stderr, "bytes must be greater than zero\n");
+        return 1;
+    }
+
+    data = malloc(BENCH_MAX_SIZE);
+    if(!data)
+        return 1;
+    for(size_t pos = 0; pos < BENCH_MAX_SIZE; pos++)
+        data[pos] = (uint8_t) (pos * 131 + (pos >> 9));
+
+    for(size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++)
+    {
+        bench_run(data, bench_sizes[s], bytes, "crc32c", bench_impl_crc32c(), utl_crc32c_data);
+        bench_run(data, bench_sizes[s], bytes, "crc16", bench_impl_crc16(), bench_crc16);
+    }
+
+    free(data);
+
+    return 0;
+}
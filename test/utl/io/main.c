@@ -0,0 +1,161 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "utl_io.h"
+
+// bytes 0x01, 0x02, ..., lidos e escritos a partir de deslocamentos desalinhados
+static uint8_t test_buf[16];
+
+static void test_fill(void)
+{
+    for(size_t n = 0; n < sizeof(test_buf); n++)
+        test_buf[n] = (uint8_t) (n + 1);
+}
+
+static void test_swap(void)
+{
+    uint8_t data[4] = {0x12, 0x34, 0x56, 0x78};
+
+    assert(utl_io_swap16(0x1234) == 0x3412);
+    assert(utl_io_swap32(0x12345678) == 0x78563412);
+    assert(utl_io_swap8b(0x01) == 0x80);
+    assert(utl_io_swap8b(0xC4) == 0x23);
+
+    utl_io_swap16p(data);
+    assert(data[0] == 0x34 && data[1] == 0x12);
+    utl_io_swap32p(data);
+    assert(data[0] == 0x78 && data[1] == 0x56 && data[2] == 0x12 && data[3] == 0x34);
+
+    printf("Swap test passed!\n");
+}
+
+static void test_get(void)
+{
+    test_fill();
+
+    for(size_t off = 0; off < 8; off++)
+    {
+        uint8_t* p = test_buf + off;
+        uint8_t b = (uint8_t) (off + 1);
+
+        assert(utl_io_get8_fl(p) == b && utl_io_get8_fb(p) == b);
+        assert(utl_io_get16_fl(p) == (uint16_t) (b | (b + 1) << 8));
+        assert(utl_io_get16_fb(p) == (uint16_t) ((b << 8) | (b + 1)));
+        assert(utl_io_get32_fl(p) == utl_io_swap32(utl_io_get32_fb(p)));
+        assert(utl_io_get32_fb(p) == ((uint32_t) b << 24 | (uint32_t) (b + 1) << 16 | (uint32_t) (b + 2) << 8 |
+                                      (uint32_t) (b + 3)));
+        assert(utl_io_get64_fl(p) == ((uint64_t) utl_io_get32_fl(p + 4) << 32 | utl_io_get32_fl(p)));
+        assert(utl_io_get64_fb(p) == ((uint64_t) utl_io_get32_fb(p) << 32 | utl_io_get32_fb(p + 4)));
+    }
+
+    // avanço do ponteiro
+    uint8_t* p = test_buf;
+    assert(utl_io_get8_fb_ap(p) == 0x01);
+    assert(utl_io_get16_fb_ap(p) == 0x0203);
+    assert(utl_io_get32_fl_ap(p) == 0x07060504);
+    assert(utl_io_get64_fb_ap(p) == 0x08090A0B0C0D0E0FULL);
+    assert(p == test_buf + 15);
+
+    printf("Get test passed!\n");
+}
+
+static void test_put(void)
+{
+    uint8_t expected[16];
+
+    for(size_t off = 0; off < 8; off++)
+    {
+        uint8_t* p = test_buf + off;
+
+        memset(test_buf, 0, sizeof(test_buf));
+        memset(expected, 0, sizeof(expected));
+        expected[off] = 0x12;
+        expected[off + 1] = 0x34;
+        utl_io_put16_tb(0x1234, p);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+        utl_io_put16_tl(0x3412, p);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+
+        for(size_t n = 0; n < 8; n++)
+            expected[off + n] = (uint8_t) (0x11 * (n + 1));
+        utl_io_put64_tb(0x1122334455667788ULL, p);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+        utl_io_put64_tl(0x8877665544332211ULL, p);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+        utl_io_put32_tl(0x44332211, p);
+        utl_io_put32_tb(0x55667788, p + 4);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+        utl_io_put8_tl(0x11, p);
+        utl_io_put8_tb(0x22, p + 1);
+        assert(memcmp(test_buf, expected, sizeof(expected)) == 0);
+    }
+
+    // avanço do ponteiro
+    uint8_t* p = test_buf;
+    utl_io_put8_tl_ap(0x01, p);
+    utl_io_put16_tl_ap(0x0302, p);
+    utl_io_put32_tb_ap(0x04050607, p);
+    utl_io_put64_tl_ap(0x0F0E0D0C0B0A0908ULL, p);
+    assert(p == test_buf + 15);
+    test_fill();
+    assert(memcmp(test_buf, (uint8_t[15]){1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, 15) == 0);
+
+    printf("Put test passed!\n");
+}
+
+static void test_float(void)
+{
+    uint8_t* p = test_buf + 1;
+    uint8_t* q = p;
+
+    // 1.5f = 0x3FC00000, -2.0 = 0xC000000000000000
+    utl_io_putf_tb(1.5f, p);
+    assert(utl_io_get32_fb(p) == 0x3FC00000);
+    assert(utl_io_getf_fb(p) == 1.5f);
+    utl_io_putf_tl(1.5f, p);
+    assert(utl_io_get32_fl(p) == 0x3FC00000);
+    assert(utl_io_getf_fl(p) == 1.5f);
+
+    utl_io_putd_tb(-2.0, p);
+    assert(utl_io_get64_fb(p) == 0xC000000000000000ULL);
+    assert(utl_io_getd_fb(p) == -2.0);
+    utl_io_putd_tl(-2.0, p);
+    assert(utl_io_get64_fl(p) == 0xC000000000000000ULL);
+    assert(utl_io_getd_fl(p) == -2.0);
+
+    utl_io_putf_tl_ap(0.25f, q);
+    utl_io_putd_tb_ap(3.0, q);
+    assert(q == p + 12);
+    q = p;
+    assert(utl_io_getf_fl_ap(q) == 0.25f);
+    assert(utl_io_getd_fb_ap(q) == 3.0);
+    assert(q == p + 12);
+
+    printf("Float/double test passed!\n");
+}
+
+static void test_memcpy(void)
+{
+    const uint8_t src[4] = {1, 2, 3, 4};
+    uint8_t dst[4];
+
+    utl_io_memcpy_tl(dst, src, sizeof(dst));
+    assert(dst[0] == 4 && dst[1] == 3 && dst[2] == 2 && dst[3] == 1);
+
+    printf("Memcpy test passed!\n");
+}
+
+int main(void)
+{
+    test_swap();
+    test_get();
+    test_put();
+    test_float();
+    test_memcpy();
+
+    return 0;
+}